@@ -0,0 +1,93 @@
+#ifndef emc_bench_h
+#define emc_bench_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/stats.h>
+#include <ctime>
+#include <cstdio>
+
+namespace emc {
+namespace bench {
+
+/* bench_time_min
+   minimum amount of time to spend measuring each case, in nanoseconds
+*/
+constexpr std::uint64_t bench_time_min = 200000000u;
+
+inline std::uint64_t get_time() noexcept
+{
+      timespec l_time;
+      clock_gettime(CLOCK_MONOTONIC, std::addressof(l_time));
+      return l_time.tv_sec * 1000000000ull + l_time.tv_nsec;
+}
+
+/* keep()
+   prevent the compiler from optimizing away a computed value
+*/
+template<typename Xt>
+inline void  keep(Xt&& value) noexcept
+{
+      asm volatile("" : : "g"(std::addressof(value)) : "memory");
+}
+
+/* report()
+   print out the results of a case, either as a line of text or as a JSON object; size is the number of bytes processed per
+   operation, ticks are timestamp counter ticks (which on most current cpus run at the nominal, not the actual clock rate)
+*/
+void  report(const char* name, std::size_t size, std::uint64_t count, std::uint64_t time, std::uint64_t ticks) noexcept;
+
+/* run()
+   calibrate the iteration count so that the case runs for at least bench_time_min, then measure and report it
+*/
+template<typename Fn>
+inline void  run(const char* name, std::size_t size, Fn&& fn) noexcept
+{
+      std::uint64_t l_count = 1u;
+      std::uint64_t l_time;
+      std::uint64_t l_ticks;
+      while(true) {
+          std::uint64_t l_time_start = get_time();
+          std::uint64_t l_tick_start = probe::get_tick();
+          for(std::uint64_t i_iteration = 0; i_iteration < l_count; i_iteration++) {
+              fn();
+          }
+          l_ticks = probe::get_tick() - l_tick_start;
+          l_time = get_time() - l_time_start;
+          if(l_time >= bench_time_min) {
+              break;
+          }
+          if(l_time < bench_time_min / 16) {
+              l_count *= 16;
+          } else
+              l_count = l_count * bench_time_min / l_time + 1;
+      }
+      report(name, size, l_count, l_time, l_ticks);
+}
+
+void  bench_pipeline() noexcept;
+bool  bench_codec() noexcept;
+bool  bench_cipher() noexcept;
+
+/*namespace bench*/ }
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,275 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bench.h"
+#include <emc/transport.h>
+#include <cstring>
+#include <iterator>
+
+namespace emc {
+namespace bench {
+
+/* cipher_case_t
+   one of the poly1305 test vectors of RFC 8439, appendix A.3; the data is zero padded to fit the largest of them
+*/
+struct cipher_case_t {
+  std::uint8_t  key[transport::chacha20_key_size];
+  std::uint8_t  data[64];
+  std::size_t   size;
+  std::uint8_t  tag[transport::poly1305::tag_size];
+};
+
+/* cipher_check()
+   compare the output of a kernel with the result given by the test vector
+*/
+static bool  cipher_check(const char* name, const std::uint8_t* data, const std::uint8_t* expect, std::size_t size) noexcept
+{
+      if(std::memcmp(data, expect, size) != 0) {
+          std::fprintf(stderr, "%s: output does not match the RFC 8439 test vector\n", name);
+          return false;
+      }
+      return true;
+}
+
+/* cipher_verify()
+   run the kernels over the test vectors of RFC 8439 before measuring them: the chacha20 block function (2.3.2),
+   encryption (2.4.2), poly1305 (2.5.2), the AEAD construction (2.8.2) and the poly1305 cases of appendix A.3 (#5 to
+   #11) which exercise the carries and the final reduction
+*/
+static bool  cipher_verify() noexcept
+{
+      static constexpr char s_text[] =
+          "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+      static constexpr std::size_t s_text_size = sizeof(s_text) - 1;
+      static constexpr std::uint8_t s_block_nonce[] = {0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00};
+      static constexpr std::uint8_t s_block[] = {
+          0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+          0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+          0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+          0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+      };
+      static constexpr std::uint8_t s_xor_nonce[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00};
+      static constexpr std::uint8_t s_xor[] = {
+          0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+          0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2, 0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+          0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+          0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+          0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61, 0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+          0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+          0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+          0x87, 0x4d
+      };
+      static constexpr std::uint8_t s_mac_key[] = {
+          0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33, 0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+          0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd, 0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b
+      };
+      static constexpr char s_mac_text[] = "Cryptographic Forum Research Group";
+      static constexpr std::uint8_t s_mac_tag[] = {
+          0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6, 0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9
+      };
+      static constexpr std::uint8_t s_aead_nonce[] = {0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47};
+      static constexpr std::uint8_t s_aead_ad[] = {0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7};
+      static constexpr std::uint8_t s_aead[] = {
+          0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+          0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe, 0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+          0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+          0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+          0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c, 0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+          0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+          0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+          0x61, 0x16
+      };
+      static constexpr std::uint8_t s_aead_tag[] = {
+          0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91
+      };
+      static constexpr cipher_case_t s_case_list[] = {
+          // #5
+          {
+            {
+              0x02
+            },
+            {
+              0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+            },
+            16,
+            {
+              0x03
+            }
+          },
+          // #6
+          {
+            {
+              0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+            },
+            {
+              0x02
+            },
+            16,
+            {
+              0x03
+            }
+          },
+          // #7
+          {
+            {
+              0x01
+            },
+            {
+              0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+              0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+              0x11
+            },
+            48,
+            {
+              0x05
+            }
+          },
+          // #8
+          {
+            {
+              0x01
+            },
+            {
+              0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+              0xfb, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe,
+              0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01
+            },
+            48,
+            {
+              0x00
+            }
+          },
+          // #9
+          {
+            {
+              0x02
+            },
+            {
+              0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+            },
+            16,
+            {
+              0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+            }
+          },
+          // #10
+          {
+            {
+              0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04
+            },
+            {
+              0xe3, 0x35, 0x94, 0xd7, 0x50, 0x5e, 0x43, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0x33, 0x94, 0xd7, 0x50, 0x5e, 0x43, 0x79, 0xcd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0x01
+            },
+            64,
+            {
+              0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55
+            }
+          },
+          // #11
+          {
+            {
+              0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04
+            },
+            {
+              0xe3, 0x35, 0x94, 0xd7, 0x50, 0x5e, 0x43, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0x33, 0x94, 0xd7, 0x50, 0x5e, 0x43, 0x79, 0xcd, 0x01
+            },
+            48,
+            {
+              0x13
+            }
+          }
+      };
+      bool         l_success = true;
+      std::uint8_t l_key[transport::chacha20_key_size];
+      std::uint8_t l_data[sizeof(s_text)];
+      std::uint8_t l_tag[transport::poly1305::tag_size];
+      char         l_name[64];
+      for(std::size_t i_byte = 0; i_byte < sizeof(l_key); i_byte++) {
+          l_key[i_byte] = i_byte;
+      }
+      transport::chacha20_block(l_data, l_key, s_block_nonce, 1);
+      l_success &= cipher_check("cipher/chacha20/block", l_data, s_block, sizeof(s_block));
+      transport::chacha20_xor(l_data, reinterpret_cast<const std::uint8_t*>(s_text), s_text_size, l_key, s_xor_nonce, 1);
+      l_success &= cipher_check("cipher/chacha20/xor", l_data, s_xor, sizeof(s_xor));
+      transport::poly1305_mac(l_tag, reinterpret_cast<const std::uint8_t*>(s_mac_text), sizeof(s_mac_text) - 1, s_mac_key);
+      l_success &= cipher_check("cipher/poly1305/mac", l_tag, s_mac_tag, sizeof(s_mac_tag));
+      for(std::size_t i_byte = 0; i_byte < sizeof(l_key); i_byte++) {
+          l_key[i_byte] = 0x80 + i_byte;
+      }
+      std::memcpy(l_data, s_text, s_text_size);
+      transport::chacha20_poly1305_seal(l_tag, l_data, s_text_size, s_aead_ad, sizeof(s_aead_ad), l_key, s_aead_nonce);
+      l_success &= cipher_check("cipher/chacha20-poly1305/seal", l_data, s_aead, sizeof(s_aead));
+      l_success &= cipher_check("cipher/chacha20-poly1305/tag", l_tag, s_aead_tag, sizeof(s_aead_tag));
+      if(transport::chacha20_poly1305_open(s_aead_tag, l_data, s_text_size, s_aead_ad, sizeof(s_aead_ad), l_key, s_aead_nonce) == false) {
+          std::fprintf(stderr, "cipher/chacha20-poly1305/open: the RFC 8439 test vector fails to authenticate\n");
+          l_success = false;
+      } else
+          l_success &= cipher_check("cipher/chacha20-poly1305/open", l_data, reinterpret_cast<const std::uint8_t*>(s_text), s_text_size);
+      for(std::size_t i_case = 0; i_case < std::size(s_case_list); i_case++) {
+          const cipher_case_t& l_case = s_case_list[i_case];
+          std::snprintf(l_name, sizeof(l_name), "cipher/poly1305/a.3/%zu", i_case + 5);
+          transport::poly1305_mac(l_tag, l_case.data, l_case.size, l_case.key);
+          l_success &= cipher_check(l_name, l_tag, l_case.tag, sizeof(l_case.tag));
+      }
+      return l_success;
+}
+
+bool  bench_cipher() noexcept
+{
+      static constexpr std::size_t s_size_list[] = {64, 256, 1024, 16384};
+      static std::uint8_t s_data[16384 + transport::poly1305::tag_size];
+      std::uint8_t l_key[transport::chacha20_key_size];
+      std::uint8_t l_nonce[transport::chacha20_nonce_size];
+      std::uint8_t l_tag[transport::poly1305::tag_size];
+      char         l_name[64];
+      std::memset(s_data, 0x5a, sizeof(s_data));
+      std::memset(l_key, 0x33, sizeof(l_key));
+      std::memset(l_nonce, 0x44, sizeof(l_nonce));
+      if(cipher_verify() == false) {
+          return false;
+      }
+      for(std::size_t l_size : s_size_list) {
+          std::snprintf(l_name, sizeof(l_name), "cipher/chacha20/%zu", l_size);
+          run(l_name, l_size, [&]() {
+              transport::chacha20_xor(s_data, s_data, l_size, l_key, l_nonce, 1);
+              keep(s_data[0]);
+          });
+          std::snprintf(l_name, sizeof(l_name), "cipher/poly1305/%zu", l_size);
+          run(l_name, l_size, [&]() {
+              transport::poly1305_mac(l_tag, s_data, l_size, l_key);
+              keep(l_tag[0]);
+          });
+          std::snprintf(l_name, sizeof(l_name), "cipher/chacha20-poly1305/seal/%zu", l_size);
+          run(l_name, l_size, [&]() {
+              transport::chacha20_poly1305_seal(l_tag, s_data, l_size, l_nonce, sizeof(l_nonce), l_key, l_nonce);
+              keep(l_tag[0]);
+          });
+      }
+      return true;
+}
+
+/*namespace bench*/ }
+/*namespace emc*/ }
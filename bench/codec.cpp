@@ -0,0 +1,247 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bench.h"
+#include "config.h"
+#include <emc/transport.h>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace emc {
+namespace bench {
+
+/* codec_size_list, codec_size_max
+   payload sizes the codecs are measured at: from a short command up to bulk transfers
+*/
+static constexpr std::size_t codec_size_list[] = {8u, 64u, 512u, 4096u, 32768u, 262144u, 1048576u};
+static constexpr std::size_t codec_size_max = 1048576u;
+
+/* codec_align
+   alignment of the buffers; the misaligned cases offset both the source and the destination by one byte from it
+*/
+static constexpr std::size_t codec_align = 64u;
+
+/* uart_format_base16, uart_format_base64, uart_format_cobs
+   the uart codec formats, see uart::codec_format_*
+*/
+static constexpr int uart_format_base16 = 1;
+static constexpr int uart_format_base64 = 2;
+static constexpr int uart_format_cobs = 3;
+static constexpr std::uint8_t uart_cobs_delimiter = '\n';
+
+/* uart_codec
+   the encode and decode halves of the uart stage, outside of a pipeline: a payload is cut into mtu sized chunks which are
+   each encoded into a packet and then decoded back, the same way uart::emc_std_return_packet() and
+   uart::emc_std_process_packet() do it
+*/
+class uart_codec
+{
+  int                       m_format;
+  std::uint8_t*             m_packet_ptr;
+  transport::base16_decoder m_base16_decoder;
+  transport::base64_decoder m_base64_decoder;
+
+  public:
+          uart_codec(int format, std::uint8_t* packet_ptr) noexcept:
+          m_format(format),
+          m_packet_ptr(packet_ptr),
+          m_base16_decoder(),
+          m_base64_decoder() {
+  }
+
+  /* get_chunk_size()
+     see uart::emi_get_chunk_size()
+  */
+  static  std::size_t get_chunk_size(int format) noexcept {
+          if(format == uart_format_base16) {
+              return mtu_size / 2;
+          } else
+          if(format == uart_format_base64) {
+              return mtu_size / 4 * 3;
+          } else
+          if(format == uart_format_cobs) {
+              return mtu_size - mtu_size / 254 - 1;
+          }
+          return mtu_size;
+  }
+
+  static  std::size_t get_packet_size(int format) noexcept {
+          if(format == uart_format_base16) {
+              return transport::base16_encoder::get_size_max(get_chunk_size(format));
+          } else
+          if(format == uart_format_base64) {
+              return transport::base64_encoder::get_size_max(get_chunk_size(format));
+          }
+          return transport::cobs_get_encode_size(get_chunk_size(format));
+  }
+
+  /* transfer()
+     round trip `size` bytes from `src` to `dst`; returns the number of bytes written to `dst`, which is short of `size`
+     if any of the packets failed to decode
+  */
+          std::size_t transfer(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept {
+          std::size_t l_chunk_size = get_chunk_size(m_format);
+          std::size_t l_packet_size;
+          std::size_t l_error_offset;
+          auto        p_dst = dst;
+          while(size > 0) {
+              std::size_t l_size = size;
+              if(l_size > l_chunk_size) {
+                  l_size = l_chunk_size;
+              }
+              if(m_format == uart_format_base16) {
+                  l_packet_size = transport::base16_encode(m_packet_ptr, src, l_size);
+                  m_base16_decoder.reset();
+                  p_dst += m_base16_decoder.update(p_dst, m_packet_ptr, l_packet_size);
+                  p_dst += m_base16_decoder.finish(p_dst);
+                  if(m_base16_decoder.has_error()) {
+                      break;
+                  }
+              } else
+              if(m_format == uart_format_base64) {
+                  l_packet_size = transport::base64_encode(m_packet_ptr, src, l_size);
+                  m_base64_decoder.reset();
+                  p_dst += m_base64_decoder.update(p_dst, m_packet_ptr, l_packet_size);
+                  p_dst += m_base64_decoder.finish(p_dst);
+              } else
+              if(m_format == uart_format_cobs) {
+                  l_packet_size = transport::cobs_encode(m_packet_ptr, src, l_size, uart_cobs_delimiter);
+                  p_dst += transport::cobs_decode(p_dst, m_packet_ptr, l_packet_size, l_error_offset, uart_cobs_delimiter);
+                  if(l_error_offset != l_packet_size) {
+                      break;
+                  }
+              } else
+                  break;
+              src  += l_size;
+              size -= l_size;
+          }
+          return p_dst - dst;
+  }
+};
+
+static std::uint8_t* codec_alloc(std::size_t size) noexcept
+{
+      return reinterpret_cast<std::uint8_t*>(std::aligned_alloc(codec_align, get_round_value(size + codec_align, codec_align)));
+}
+
+/* codec_check()
+   make sure a decoded payload matches the original before measuring anything with it; base64_decode() knows nothing
+   about padding and decodes a padded group in full, so up to `slack_size` trailing bytes of the copy are not compared
+*/
+static bool  codec_check(const char* name, const std::uint8_t* data, std::size_t data_size, const std::uint8_t* copy, std::size_t copy_size, std::size_t slack_size = 0) noexcept
+{
+      if((copy_size < data_size) ||
+          (copy_size > data_size + slack_size) ||
+          (std::memcmp(data, copy, data_size) != 0)) {
+          std::fprintf(stderr, "%s: decoded data does not match the input\n", name);
+          return false;
+      }
+      return true;
+}
+
+bool  bench_codec() noexcept
+{
+      static constexpr const char* s_align_name[] = {"aligned", "misaligned"};
+      static constexpr int s_uart_format[] = {uart_format_base16, uart_format_base64, uart_format_cobs};
+      static constexpr const char* s_uart_format_name[] = {"base16", "base64", "cobs"};
+      bool          l_success = true;
+      std::uint8_t* l_data_ptr = codec_alloc(codec_size_max);
+      std::uint8_t* l_code_ptr = codec_alloc(codec_size_max * 2);
+      std::uint8_t* l_copy_ptr = codec_alloc(codec_size_max);
+      std::uint8_t* l_packet_ptr = codec_alloc(uart_codec::get_packet_size(uart_format_base16));
+      std::uint32_t l_seed = 0x9e3779b9u;
+      char          l_name[64];
+      if((l_data_ptr == nullptr) ||
+          (l_code_ptr == nullptr) ||
+          (l_copy_ptr == nullptr) ||
+          (l_packet_ptr == nullptr)) {
+          std::fprintf(stderr, "codec: out of memory\n");
+          std::free(l_packet_ptr);
+          std::free(l_copy_ptr);
+          std::free(l_code_ptr);
+          std::free(l_data_ptr);
+          return false;
+      }
+      for(std::size_t i_byte = 0; i_byte < codec_size_max + codec_align; i_byte++) {
+          l_seed ^= l_seed << 13;
+          l_seed ^= l_seed >> 17;
+          l_seed ^= l_seed << 5;
+          l_data_ptr[i_byte] = l_seed;
+      }
+      for(std::size_t i_align = 0; i_align < 2; i_align++) {
+          std::uint8_t* p_data = l_data_ptr + i_align;
+          std::uint8_t* p_code = l_code_ptr + i_align;
+          std::uint8_t* p_copy = l_copy_ptr + i_align;
+          for(std::size_t l_size : codec_size_list) {
+              std::size_t l_code_size;
+              std::size_t l_copy_size;
+              // base16
+              std::snprintf(l_name, sizeof(l_name), "codec/base16/encode/%s", s_align_name[i_align]);
+              run(l_name, l_size, [&]() {
+                  keep(transport::base16_encode(p_code, p_data, l_size));
+              });
+              l_code_size = transport::base16_encode(p_code, p_data, l_size);
+              l_copy_size = transport::base16_decode(p_copy, p_code, l_code_size);
+              std::snprintf(l_name, sizeof(l_name), "codec/base16/decode/%s", s_align_name[i_align]);
+              if(codec_check(l_name, p_data, l_size, p_copy, l_copy_size)) {
+                  run(l_name, l_size, [&]() {
+                      keep(transport::base16_decode(p_copy, p_code, l_code_size));
+                  });
+              } else
+                  l_success = false;
+              // base64
+              std::snprintf(l_name, sizeof(l_name), "codec/base64/encode/%s", s_align_name[i_align]);
+              run(l_name, l_size, [&]() {
+                  keep(transport::base64_encode(p_code, p_data, l_size));
+              });
+              l_code_size = transport::base64_encode(p_code, p_data, l_size);
+              l_copy_size = transport::base64_decode(p_copy, p_code, l_code_size);
+              std::snprintf(l_name, sizeof(l_name), "codec/base64/decode/%s", s_align_name[i_align]);
+              if(codec_check(l_name, p_data, l_size, p_copy, l_copy_size, 2)) {
+                  run(l_name, l_size, [&]() {
+                      keep(transport::base64_decode(p_copy, p_code, l_code_size));
+                  });
+              } else
+                  l_success = false;
+              // uart round trip
+              for(std::size_t i_format = 0; i_format < std::size(s_uart_format); i_format++) {
+                  uart_codec l_uart(s_uart_format[i_format], l_packet_ptr);
+                  std::snprintf(l_name, sizeof(l_name), "uart/%s/roundtrip/%s", s_uart_format_name[i_format], s_align_name[i_align]);
+                  l_copy_size = l_uart.transfer(p_copy, p_data, l_size);
+                  if(codec_check(l_name, p_data, l_size, p_copy, l_copy_size)) {
+                      run(l_name, l_size, [&]() {
+                          keep(l_uart.transfer(p_copy, p_data, l_size));
+                      });
+                  } else
+                      l_success = false;
+              }
+          }
+      }
+      std::free(l_packet_ptr);
+      std::free(l_copy_ptr);
+      std::free(l_code_ptr);
+      std::free(l_data_ptr);
+      return l_success;
+}
+
+/*namespace bench*/ }
+/*namespace emc*/ }
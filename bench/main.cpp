@@ -0,0 +1,110 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bench.h"
+#include <emc/transport.h>
+#include <cstring>
+
+namespace emc {
+namespace bench {
+
+static bool         s_json;
+static std::size_t  s_report_count;
+
+void  report(const char* name, std::size_t size, std::uint64_t count, std::uint64_t time, std::uint64_t ticks) noexcept
+{
+      double l_time_per_op = static_cast<double>(time) / count;
+      double l_rate = 0.0;
+      double l_ticks_per_byte = 0.0;
+      if(size > 0) {
+          l_rate = static_cast<double>(size) * count / time;
+          l_ticks_per_byte = static_cast<double>(ticks) / count / size;
+      }
+      if(s_json) {
+          std::printf(
+              "%s\n    {\"name\": \"%s\", \"size\": %zu, \"ns_per_op\": %.2f, \"gb_per_s\": %.3f, \"ticks_per_byte\": %.2f}",
+              s_report_count > 0 ? "," : "",
+              name,
+              size,
+              l_time_per_op,
+              l_rate,
+              l_ticks_per_byte
+          );
+      } else
+          std::printf("%-48s %10zu %12.2f ns/op %10.3f GB/s %8.2f c/B\n", name, size, l_time_per_op, l_rate, l_ticks_per_byte);
+      s_report_count++;
+}
+
+/* report_begin(), report_end()
+   open and close the report; the kernels the codecs and the cipher picked on this machine go first, so that runs with
+   and without EMC_NO_SIMD in the environment can be told apart
+*/
+static void  report_begin() noexcept
+{
+      if(s_json) {
+          std::printf(
+              "{\n  \"kernel\": {\"base16\": \"%s\", \"base64\": \"%s\", \"cobs\": \"%s\", \"chacha20\": \"%s\"},\n  \"results\": [",
+              transport::base16_get_kernel_name(),
+              transport::base64_get_kernel_name(),
+              transport::cobs_get_kernel_name(),
+              transport::chacha20_get_kernel_name()
+          );
+      } else
+          std::printf(
+              "kernel: base16=%s base64=%s cobs=%s chacha20=%s\n",
+              transport::base16_get_kernel_name(),
+              transport::base64_get_kernel_name(),
+              transport::cobs_get_kernel_name(),
+              transport::chacha20_get_kernel_name()
+          );
+}
+
+static void  report_end(bool success) noexcept
+{
+      if(s_json) {
+          std::printf("\n  ],\n  \"success\": %s\n}\n", success ? "true" : "false");
+      }
+}
+
+/*namespace bench*/ }
+/*namespace emc*/ }
+
+/* main()
+   usage: emc_bench [--json]
+   returns non-zero if any of the cases failed to check its output
+*/
+int main(int argc, char** argv)
+{
+      bool  l_success = true;
+      for(int i_arg = 1; i_arg < argc; i_arg++) {
+          if(std::strcmp(argv[i_arg], "--json") != 0) {
+              std::fprintf(stderr, "usage: %s [--json]\n", argv[0]);
+              return 2;
+          }
+          emc::bench::s_json = true;
+      }
+      emc::bench::report_begin();
+      emc::bench::bench_pipeline();
+      l_success &= emc::bench::bench_codec();
+      l_success &= emc::bench::bench_cipher();
+      emc::bench::report_end(l_success);
+      return l_success ? 0 : 1;
+}
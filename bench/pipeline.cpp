@@ -0,0 +1,142 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "bench.h"
+#include <emc/reactor.h>
+#include <emc/static_pipeline.h>
+
+namespace emc {
+namespace bench {
+
+/* relay
+   trivial stage which touches the message on both paths, so that the calls can't be optimized away
+*/
+template<int Index>
+class relay: public emc::static_stage<relay<Index>>
+{
+  std::uint8_t  m_value;
+
+  public:
+          relay() noexcept:
+          static_stage<relay<Index>>(),
+          m_value(0u) {
+  }
+
+          int   emc_static_recv(int&, std::uint8_t*& data, std::size_t&) noexcept {
+          m_value ^= data[Index];
+          return err_okay;
+  }
+
+          int   emc_static_send(int&, std::uint8_t*& data, std::size_t&) noexcept {
+          m_value += data[Index];
+          return err_okay;
+  }
+
+  /* send()
+     start a message on the return path of a dynamic pipeline, from this stage
+  */
+          int   send(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          return this->emc_raw_send(bus, data, size);
+  }
+};
+
+/* sink
+   reactor which accepts the messages coming out of the pipeline
+*/
+class sink: public emc::reactor
+{
+  std::size_t   m_recv_size;
+  std::size_t   m_send_size;
+
+  protected:
+  virtual int   emc_raw_event(event id, const event_info_t& info) noexcept override {
+          if(id == event::recv) {
+              m_recv_size += info.recv.size;
+              return err_okay;
+          } else
+          if(id == event::send) {
+              m_send_size += info.send.size;
+              return err_okay;
+          }
+          return reactor::emc_raw_event(id, info);
+  }
+
+  public:
+          sink() noexcept:
+          reactor(),
+          m_recv_size(0),
+          m_send_size(0) {
+  }
+
+          bool  attach(stage* stage_ptr) noexcept {
+          return pod_attach_stage(stage_ptr);
+  }
+
+          int   recv(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          return emc_raw_recv(bus, data, size);
+  }
+};
+
+class dynamic_sink: public sink
+{
+  relay<0> m_stage_0;
+  relay<1> m_stage_1;
+  relay<2> m_stage_2;
+  relay<3> m_stage_3;
+
+  public:
+          dynamic_sink() noexcept:
+          sink() {
+          attach(std::addressof(m_stage_0));
+          attach(std::addressof(m_stage_1));
+          attach(std::addressof(m_stage_2));
+          attach(std::addressof(m_stage_3));
+  }
+
+          int   send(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          return m_stage_3.send(bus, data, size);
+  }
+};
+
+using static_sink = emc::static_pipeline<sink, relay<0>, relay<1>, relay<2>, relay<3>>;
+
+void  bench_pipeline() noexcept
+{
+      std::uint8_t  l_data[64];
+      dynamic_sink  l_dynamic;
+      static_sink   l_static;
+      std::memset(l_data, 0x5a, sizeof(l_data));
+      run("pipeline/dynamic/recv/4", sizeof(l_data), [&]() {
+          keep(l_dynamic.recv(0, l_data, sizeof(l_data)));
+      });
+      run("pipeline/static/recv/4", sizeof(l_data), [&]() {
+          keep(l_static.recv(0, l_data, sizeof(l_data)));
+      });
+      run("pipeline/dynamic/send/4", sizeof(l_data), [&]() {
+          keep(l_dynamic.send(0, l_data, sizeof(l_data)));
+      });
+      run("pipeline/static/send/4", sizeof(l_data), [&]() {
+          keep(l_static.send(0, l_data, sizeof(l_data)));
+      });
+}
+
+/*namespace bench*/ }
+/*namespace emc*/ }
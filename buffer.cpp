@@ -0,0 +1,185 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "buffer.h"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace emc {
+
+      buffer::buffer(std::size_t capacity, std::size_t headroom) noexcept:
+      m_refs(1),
+      m_capacity(capacity),
+      m_head(headroom),
+      m_tail(headroom)
+{
+}
+
+      buffer::~buffer()
+{
+}
+
+/* make()
+   allocate a new, empty buffer with room for a payload of the given size, plus the requested headroom and tailroom;
+   the returned buffer holds one reference
+*/
+buffer* buffer::make(std::size_t size, std::size_t headroom, std::size_t tailroom) noexcept
+{
+      std::size_t l_capacity = headroom + size + tailroom;
+      if((l_capacity >= size) &&
+          (l_capacity <= std::numeric_limits<std::size_t>::max() - sizeof(buffer))) {
+          void* l_memory = std::malloc(sizeof(buffer) + l_capacity);
+          if(l_memory != nullptr) {
+              return new(l_memory) buffer(l_capacity, headroom);
+          }
+      }
+      return nullptr;
+}
+
+/* make_copy()
+   allocate a new buffer and initialise its payload with a copy of the given data
+*/
+buffer* buffer::make_copy(const std::uint8_t* data, std::size_t size, std::size_t headroom, std::size_t tailroom) noexcept
+{
+      buffer* l_result = make(size, headroom, tailroom);
+      if(l_result != nullptr) {
+          if(size > 0u) {
+              std::memcpy(l_result->put(size), data, size);
+          }
+      }
+      return l_result;
+}
+
+/* acquire()
+   add a reference to the buffer; needs to be paired with a call to release()
+*/
+buffer* buffer::acquire() noexcept
+{
+      m_refs.fetch_add(1, std::memory_order_relaxed);
+      return this;
+}
+
+/* release()
+   drop a reference to the buffer and dispose of it when the last reference is gone
+*/
+void  buffer::release() noexcept
+{
+      if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          this->~buffer();
+          std::free(this);
+      }
+}
+
+/* is_shared()
+   check if the buffer is referenced from more than one place, in which case it should not be modified in place
+*/
+bool  buffer::is_shared() const noexcept
+{
+      return m_refs.load(std::memory_order_acquire) > 1;
+}
+
+/* clone()
+   make a private copy of the buffer, preserving the headroom and tailroom
+*/
+buffer* buffer::clone() const noexcept
+{
+      return make_copy(get_base() + m_head, m_tail - m_head, m_head, m_capacity - m_tail);
+}
+
+/* push()
+   extend the payload at the front by `size` bytes; returns the new start of the payload, or nullptr if there is not
+   enough headroom left
+*/
+std::uint8_t* buffer::push(std::size_t size) noexcept
+{
+      if(size <= m_head) {
+          m_head -= size;
+          return get_base() + m_head;
+      }
+      return nullptr;
+}
+
+/* pull()
+   strip `size` bytes off the front of the payload; returns the new start of the payload, or nullptr if the payload is
+   shorter than `size`
+*/
+std::uint8_t* buffer::pull(std::size_t size) noexcept
+{
+      if(size <= m_tail - m_head) {
+          m_head += size;
+          return get_base() + m_head;
+      }
+      return nullptr;
+}
+
+/* put()
+   extend the payload at the back by `size` bytes; returns a pointer to the appended region, or nullptr if there is not
+   enough tailroom left
+*/
+std::uint8_t* buffer::put(std::size_t size) noexcept
+{
+      if(size <= m_capacity - m_tail) {
+          std::uint8_t* l_result = get_base() + m_tail;
+          m_tail += size;
+          return l_result;
+      }
+      return nullptr;
+}
+
+/* trim()
+   strip `size` bytes off the back of the payload
+*/
+bool  buffer::trim(std::size_t size) noexcept
+{
+      if(size <= m_tail - m_head) {
+          m_tail -= size;
+          return true;
+      }
+      return false;
+}
+
+/* resize()
+   set the payload size, keeping its start in place
+*/
+bool  buffer::resize(std::size_t size) noexcept
+{
+      if(size <= m_capacity - m_head) {
+          m_tail = m_head + size;
+          return true;
+      }
+      return false;
+}
+
+/* reset()
+   discard the payload and reposition its (empty) start at the given offset from the beginning of the storage
+*/
+void  buffer::reset(std::size_t headroom) noexcept
+{
+      if(headroom > m_capacity) {
+          headroom = m_capacity;
+      }
+      m_head = headroom;
+      m_tail = headroom;
+}
+
+/*namespace emc*/ }
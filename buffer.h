@@ -0,0 +1,103 @@
+#ifndef emc_buffer_h
+#define emc_buffer_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+#include <atomic>
+
+namespace emc {
+
+/* buffer
+   reference counted message buffer; the payload is stored in a single allocation together with the control block and
+   is surrounded by reserved headroom and tailroom, so that stages are able to prepend, strip or append data in place
+   (i.e. framing, checksums, encryption tags) instead of copying the message into a buffer of their own;
+   - push()/pull(): grow/shrink the payload at the front, using the headroom;
+   - put()/trim(): grow/shrink the payload at the back, using the tailroom.
+*/
+class buffer
+{
+  std::atomic<int>  m_refs;
+  std::size_t       m_capacity;
+  std::size_t       m_head;
+  std::size_t       m_tail;
+
+  public:
+  static constexpr std::size_t headroom_default = 64u;
+  static constexpr std::size_t tailroom_default = 32u;
+
+  private:
+          buffer(std::size_t, std::size_t) noexcept;
+
+  inline  std::uint8_t* get_base() noexcept {
+          return reinterpret_cast<std::uint8_t*>(this + 1);
+  }
+
+  inline  const std::uint8_t* get_base() const noexcept {
+          return reinterpret_cast<const std::uint8_t*>(this + 1);
+  }
+
+  public:
+          buffer(const buffer&) noexcept = delete;
+          buffer(buffer&&) noexcept = delete;
+          ~buffer();
+
+  static  buffer*       make(std::size_t, std::size_t = headroom_default, std::size_t = tailroom_default) noexcept;
+  static  buffer*       make_copy(const std::uint8_t*, std::size_t, std::size_t = headroom_default, std::size_t = tailroom_default) noexcept;
+
+          buffer*       acquire() noexcept;
+          void          release() noexcept;
+          bool          is_shared() const noexcept;
+          buffer*       clone() const noexcept;
+
+  inline  std::uint8_t* get_data() noexcept {
+          return get_base() + m_head;
+  }
+
+  inline  std::size_t   get_size() const noexcept {
+          return m_tail - m_head;
+  }
+
+  inline  std::size_t   get_headroom() const noexcept {
+          return m_head;
+  }
+
+  inline  std::size_t   get_tailroom() const noexcept {
+          return m_capacity - m_tail;
+  }
+
+  inline  std::size_t   get_capacity() const noexcept {
+          return m_capacity;
+  }
+
+          std::uint8_t* push(std::size_t) noexcept;
+          std::uint8_t* pull(std::size_t) noexcept;
+          std::uint8_t* put(std::size_t) noexcept;
+          bool          trim(std::size_t) noexcept;
+          bool          resize(std::size_t) noexcept;
+          void          reset(std::size_t = headroom_default) noexcept;
+
+          buffer&       operator=(const buffer&) noexcept = delete;
+          buffer&       operator=(buffer&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -23,6 +23,12 @@
 **/
 #include "emc.h"
 
+/* EMC_ENABLE_STATS
+   set from the cmake option of the same name; it changes the layout of the stage and reactor objects, so it is
+   carried in here rather than on the compiler command line, where code built against the library would not see it
+*/
+#cmakedefine EMC_ENABLE_STATS
+
 namespace emc {
 
 /* mtu_size
@@ -48,6 +54,25 @@ constexpr int   queue_size_min = global::cache_large_max;
 */
 constexpr int   queue_size_max = 4096;
 
+/* scratch_arena_size
+ * size of the per-reactor scratch arena stages borrow from during a single dispatch; enough to hold a decoded and an
+ * encoded copy of a message of maximum size
+*/
+constexpr int   scratch_arena_size = queue_size_max * 2;
+
+/* scratch_stage_size
+ * scratch memory added to the arena for every attached stage: the copying stages (compress, checksum, cipher) each keep
+ * a framed copy of the message for as long as the stages below them are handling it, so the copies of one nested
+ * dispatch are all live at once; the spare bytes cover the framing overhead and alignment of a single stage
+*/
+constexpr int   scratch_stage_size = queue_size_max + 256;
+
+/* scratch_pool_depth
+ * how many free blocks of each size class the per-reactor pool keeps around for reuse; the largest class is
+ * queue_size_max
+*/
+constexpr int   scratch_pool_depth = 8;
+
 /* message_drop_time
  * drop a message if it is not completed within this time interval (in seconds)
 */
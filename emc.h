@@ -39,6 +39,8 @@ constexpr unsigned int stage_type_generic = 0x000000ff;
 constexpr unsigned int stage_type_bits = 0x000000ff;
 
 /* ring_flags
+   how close the peer at the other end of the pipeline is, from ring_network (anywhere) to ring_process (same process);
+   the rings are ordered, so that a peer within a given ring has get_ring_flags() >= that ring
 */
 constexpr unsigned int ring_unknown = 0u;
 constexpr unsigned int ring_network = 0u * 0x00000100;
@@ -63,6 +65,7 @@ constexpr int chid_max = 127;
 
 /* objects
 */
+class buffer;
 class reactor;
 class stage;
 class monitor;
@@ -0,0 +1,532 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "epoll.h"
+#include <emc/error.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "config.h"
+
+namespace emc {
+namespace engine {
+
+      epoll::epoll() noexcept:
+      epoll(-1)
+{
+}
+
+      epoll::epoll(int descriptor) noexcept:
+      reactor(),
+      m_poll_descriptor(descriptor),
+      m_poll_owner(false)
+{
+      epoll_event l_event;
+      if(m_poll_descriptor < 0) {
+          m_poll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+          m_poll_owner = true;
+      }
+      for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+          m_bus_list[i_bus].p_owner = this;
+          m_bus_list[i_bus].m_descriptor = -1;
+          m_bus_list[i_bus].m_events = 0u;
+          m_bus_list[i_bus].m_send_head = 0;
+          m_bus_list[i_bus].m_send_count = 0;
+      }
+      // the wake bus signals events queued from other threads via post_async()
+      m_wake_bus.p_owner = this;
+      m_wake_bus.m_descriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      m_wake_bus.m_events = EPOLLIN | EPOLLET;
+      m_wake_bus.m_send_head = 0;
+      m_wake_bus.m_send_count = 0;
+      if((m_wake_bus.m_descriptor >= 0) &&
+          (m_poll_descriptor >= 0)) {
+          l_event.events = m_wake_bus.m_events;
+          l_event.data.ptr = std::addressof(m_wake_bus);
+          epoll_ctl(m_poll_descriptor, EPOLL_CTL_ADD, m_wake_bus.m_descriptor, std::addressof(l_event));
+      }
+}
+
+      epoll::~epoll()
+{
+      for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+          if(m_bus_list[i_bus].m_descriptor >= 0) {
+              emi_bus_release(m_bus_list[i_bus].m_descriptor);
+          }
+      }
+      if(m_wake_bus.m_descriptor >= 0) {
+          if(m_poll_descriptor >= 0) {
+              epoll_ctl(m_poll_descriptor, EPOLL_CTL_DEL, m_wake_bus.m_descriptor, nullptr);
+          }
+          ::close(m_wake_bus.m_descriptor);
+      }
+      if(m_poll_owner) {
+          if(m_poll_descriptor >= 0) {
+              ::close(m_poll_descriptor);
+          }
+      }
+}
+
+auto  epoll::emi_bus_find(int descriptor) noexcept -> bus_t*
+{
+      if(descriptor >= 0) {
+          for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+              if(m_bus_list[i_bus].m_descriptor == descriptor) {
+                  return std::addressof(m_bus_list[i_bus]);
+              }
+          }
+      }
+      return nullptr;
+}
+
+/* emi_bus_acquire()
+   register a bus descriptor with the poll set, or update its event mask if already registered;
+   events are given as an epoll event mask, EPOLLIN is assumed if no input or output events are requested
+*/
+int   epoll::emi_bus_acquire(int descriptor, unsigned int events) noexcept
+{
+      bus_t*      l_bus_ptr;
+      epoll_event l_event;
+      int         l_flags;
+      int         l_ctl_op;
+      if((descriptor < 0) ||
+          (m_poll_descriptor < 0)) {
+          return err_fail;
+      }
+      if((events & (EPOLLIN | EPOLLPRI | EPOLLOUT)) == 0u) {
+          events |= EPOLLIN;
+      }
+      l_bus_ptr = emi_bus_find(descriptor);
+      if(l_bus_ptr == nullptr) {
+          for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+              if(m_bus_list[i_bus].m_descriptor < 0) {
+                  l_bus_ptr = std::addressof(m_bus_list[i_bus]);
+                  break;
+              }
+          }
+          if(l_bus_ptr == nullptr) {
+              return err_fail;
+          }
+          // edge triggered polling requires the descriptor to be drained on each wakeup, so reads must not block
+          l_flags = fcntl(descriptor, F_GETFL, 0);
+          if(l_flags < 0) {
+              return err_fail;
+          }
+          if((l_flags & O_NONBLOCK) == 0) {
+              if(fcntl(descriptor, F_SETFL, l_flags | O_NONBLOCK) < 0) {
+                  return err_fail;
+              }
+          }
+          l_bus_ptr->m_send_head = 0;
+          l_bus_ptr->m_send_count = 0;
+          l_ctl_op = EPOLL_CTL_ADD;
+      } else
+      if(l_bus_ptr->m_send_count > 0) {
+          // keep watching for the bus to become writable while there is output pending on it
+          events |= EPOLLOUT;
+          l_ctl_op = EPOLL_CTL_MOD;
+      } else
+          l_ctl_op = EPOLL_CTL_MOD;
+      l_event.events = events | EPOLLET | EPOLLRDHUP;
+      l_event.data.ptr = l_bus_ptr;
+      if(epoll_ctl(m_poll_descriptor, l_ctl_op, descriptor, std::addressof(l_event)) < 0) {
+          return err_fail;
+      }
+      l_bus_ptr->m_descriptor = descriptor;
+      l_bus_ptr->m_events = l_event.events;
+      return err_okay;
+}
+
+/* emi_bus_release()
+   remove a bus descriptor from the poll set; the descriptor itself remains owned by the stage that acquired it
+*/
+int   epoll::emi_bus_release(int descriptor) noexcept
+{
+      bus_t* l_bus_ptr = emi_bus_find(descriptor);
+      if(l_bus_ptr != nullptr) {
+          emi_bus_clear(l_bus_ptr);
+          if(m_poll_descriptor >= 0) {
+              epoll_ctl(m_poll_descriptor, EPOLL_CTL_DEL, descriptor, nullptr);
+          }
+          l_bus_ptr->m_descriptor = -1;
+          l_bus_ptr->m_events = 0u;
+          return err_okay;
+      }
+      return err_not_required;
+}
+
+/* emi_bus_send()
+   write a message coming out of the pipeline onto its bus; whatever the descriptor does not take in straight away is
+   queued on the bus, to be written out once it becomes writable, so the byte stream always reaches the peer whole;
+   messages are refused up front (err_fail) rather than cut short if the queue can not take all of them in
+*/
+int   epoll::emi_bus_send(int descriptor, std::uint8_t* data, std::size_t size) noexcept
+{
+      bus_t*  l_bus_ptr = emi_bus_find(descriptor);
+      ssize_t l_write_size;
+      if(l_bus_ptr != nullptr) {
+          if(send_queue_max - l_bus_ptr->m_send_count < static_cast<int>((size + queue_size_max - 1) / queue_size_max)) {
+              return err_fail;
+          }
+          // keep the order of the messages: there is output pending already, so this one has to wait its turn
+          if(l_bus_ptr->m_send_count > 0) {
+              if(emi_bus_push(l_bus_ptr, data, size) == false) {
+                  return err_fail;
+              }
+              return err_okay;
+          }
+      }
+      while(size > 0) {
+          l_write_size = ::write(descriptor, data, size);
+          if(l_write_size < 0) {
+              if(errno == EINTR) {
+                  continue;
+              }
+              if((errno == EAGAIN) ||
+                  (errno == EWOULDBLOCK)) {
+                  if(l_bus_ptr != nullptr) {
+                      if(emi_bus_push(l_bus_ptr, data, size) == false) {
+                          // part of the message is out already, the stream can not be recovered
+                          hup(descriptor);
+                          return err_fail;
+                      }
+                      return err_okay;
+                  }
+                  // not one of our buses, so there is no telling when it becomes writable: wait for it
+                  pollfd l_poll;
+                  l_poll.fd = descriptor;
+                  l_poll.events = POLLOUT;
+                  l_poll.revents = 0;
+                  if((::poll(std::addressof(l_poll), 1, -1) < 0) &&
+                      (errno != EINTR)) {
+                      return err_fail;
+                  }
+                  continue;
+              }
+              return err_fail;
+          }
+          data += l_write_size;
+          size -= l_write_size;
+      }
+      return err_okay;
+}
+
+/* emi_bus_push()
+   copy (the rest of) a message onto the output queue of a bus, in as many pool blocks as it takes, and start watching
+   for the bus to become writable
+*/
+bool  epoll::emi_bus_push(bus_t* bus_ptr, const std::uint8_t* data, std::size_t size) noexcept
+{
+      bool l_arm_bit = bus_ptr->m_send_count == 0;
+      while(size > 0) {
+          std::size_t   l_copy_size = size;
+          std::uint8_t* l_copy_ptr;
+          if(bus_ptr->m_send_count >= send_queue_max) {
+              return false;
+          }
+          if(l_copy_size > static_cast<std::size_t>(queue_size_max)) {
+              l_copy_size = queue_size_max;
+          }
+          l_copy_ptr = pod_get_block(l_copy_size);
+          if(l_copy_ptr == nullptr) {
+              return false;
+          }
+          std::memcpy(l_copy_ptr, data, l_copy_size);
+          send_t& l_send = bus_ptr->m_send_list[(bus_ptr->m_send_head + bus_ptr->m_send_count) % send_queue_max];
+          l_send.data = l_copy_ptr;
+          l_send.size = l_copy_size;
+          l_send.offset = 0u;
+          bus_ptr->m_send_count++;
+          data += l_copy_size;
+          size -= l_copy_size;
+      }
+      if(l_arm_bit) {
+          emi_bus_acquire(bus_ptr->m_descriptor, (bus_ptr->m_events & ~(EPOLLET | EPOLLRDHUP)) | EPOLLOUT);
+      }
+      return true;
+}
+
+/* emi_bus_flush()
+   write out the output pending on a bus, for as long as the descriptor takes it in; stop watching for the bus to
+   become writable once the queue is empty
+*/
+void  epoll::emi_bus_flush(bus_t* bus_ptr) noexcept
+{
+      ssize_t l_write_size;
+      while(bus_ptr->m_send_count > 0) {
+          send_t& l_send = bus_ptr->m_send_list[bus_ptr->m_send_head];
+          l_write_size = ::write(bus_ptr->m_descriptor, l_send.data + l_send.offset, l_send.size - l_send.offset);
+          if(l_write_size < 0) {
+              if(errno == EINTR) {
+                  continue;
+              }
+              if((errno == EAGAIN) ||
+                  (errno == EWOULDBLOCK)) {
+                  return;
+              }
+              // the bus is broken, the hangup is reported along with the error
+              emi_bus_clear(bus_ptr);
+              return;
+          }
+          l_send.offset += l_write_size;
+          if(l_send.offset == l_send.size) {
+              pod_put_block(l_send.data, l_send.size);
+              bus_ptr->m_send_head = (bus_ptr->m_send_head + 1) % send_queue_max;
+              bus_ptr->m_send_count--;
+          }
+      }
+      bus_ptr->m_send_head = 0;
+      emi_bus_acquire(bus_ptr->m_descriptor, bus_ptr->m_events & ~(EPOLLOUT | EPOLLET | EPOLLRDHUP));
+}
+
+/* emi_bus_clear()
+   drop the output pending on a bus
+*/
+void  epoll::emi_bus_clear(bus_t* bus_ptr) noexcept
+{
+      while(bus_ptr->m_send_count > 0) {
+          send_t& l_send = bus_ptr->m_send_list[bus_ptr->m_send_head];
+          pod_put_block(l_send.data, l_send.size);
+          bus_ptr->m_send_head = (bus_ptr->m_send_head + 1) % send_queue_max;
+          bus_ptr->m_send_count--;
+      }
+      bus_ptr->m_send_head = 0;
+}
+
+/* emi_bus_dispatch()
+   handle the readiness events reported for a bus: write out any pending output, drain the descriptor, so that no data
+   is lost if the peer hung up meanwhile, then report the hangup
+*/
+void  epoll::emi_bus_dispatch(bus_t* bus_ptr, unsigned int events) noexcept
+{
+      std::uint64_t l_wake_count;
+      int           l_descriptor = bus_ptr->m_descriptor;
+      if(bus_ptr == std::addressof(m_wake_bus)) {
+          if(::read(l_descriptor, std::addressof(l_wake_count), sizeof(l_wake_count)) > 0) {
+              pod_drain_queue();
+          }
+      } else
+      if(l_descriptor >= 0) {
+          if(events & EPOLLOUT) {
+              if(bus_ptr->m_send_count > 0) {
+                  emi_bus_flush(bus_ptr);
+              }
+          }
+          if(events & (EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+              feed(l_descriptor);
+          }
+          if(events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+              if(bus_ptr->m_descriptor == l_descriptor) {
+                  hup(l_descriptor);
+              }
+          }
+      }
+}
+
+int   epoll::emc_raw_event(event id, const event_info_t& info) noexcept
+{
+      switch(id) {
+        case event::acquire_bus:
+            return emi_bus_acquire(info.acquire_bus.descriptor, info.acquire_bus.events);
+        case event::release_bus:
+            return emi_bus_release(info.release_bus.descriptor);
+        case event::feed:
+            feed(info.feed.descriptor);
+            return err_okay;
+        case event::send:
+            return emi_bus_send(info.send.bus, info.send.data, info.send.size);
+        default:
+            break;
+      }
+      return reactor::emc_raw_event(id, info);
+}
+
+void  epoll::emc_raw_notify() noexcept
+{
+      std::uint64_t l_wake_count = 1u;
+      if(m_wake_bus.m_descriptor >= 0) {
+          if(::write(m_wake_bus.m_descriptor, std::addressof(l_wake_count), sizeof(l_wake_count)) < 0) {
+              // counter saturated: a wakeup is pending already
+          }
+      }
+}
+
+/* feed()
+   drain the descriptor and relay everything read from it into the pipeline; consecutive reads are gathered into the
+   receive buffer and passed down the pipeline as a single batch
+*/
+void  epoll::feed(int descriptor) noexcept
+{
+      message_t l_message_list[recv_batch_max];
+      int       l_message_count = 0;
+      int       l_recv_offset = 0;
+      ssize_t   l_read_size;
+      bool      l_bus_bit = emi_bus_find(descriptor) != nullptr;
+      bool      l_hup_bit = false;
+      while(true) {
+          l_read_size = ::read(descriptor, m_recv_data + l_recv_offset, recv_size_max - l_recv_offset);
+          if(l_read_size > 0) {
+              l_message_list[l_message_count].bus  = descriptor;
+              l_message_list[l_message_count].data = m_recv_data + l_recv_offset;
+              l_message_list[l_message_count].size = l_read_size;
+              l_message_count++;
+              l_recv_offset += l_read_size;
+              if((l_message_count == recv_batch_max) ||
+                  (recv_size_max - l_recv_offset < recv_size_min)) {
+                  pod_recv_batch(l_message_list, l_message_count);
+                  l_message_count = 0;
+                  l_recv_offset = 0;
+                  // the bus may have been released while processing the messages
+                  if(l_bus_bit) {
+                      if(emi_bus_find(descriptor) == nullptr) {
+                          break;
+                      }
+                  }
+              }
+          } else
+          if(l_read_size == 0) {
+              l_hup_bit = l_bus_bit;
+              break;
+          } else
+          if(errno == EINTR) {
+              continue;
+          } else
+          if((errno == EAGAIN) ||
+              (errno == EWOULDBLOCK)) {
+              break;
+          } else
+          {
+              l_hup_bit = l_bus_bit;
+              break;
+          }
+      }
+      if(l_message_count > 0) {
+          pod_recv_batch(l_message_list, l_message_count);
+      }
+      if(l_hup_bit) {
+          if(emi_bus_find(descriptor) != nullptr) {
+              hup(descriptor);
+          }
+      }
+}
+
+/* hup()
+   remove the descriptor from the poll set and notify the pipeline
+*/
+void  epoll::hup(int descriptor) noexcept
+{
+      emi_bus_release(descriptor);
+      post(event::hup, event_info_t::for_hup(descriptor));
+}
+
+/* bind()
+   move the registered buses over to another poll set, or onto a private one, if the given descriptor is negative
+*/
+bool  epoll::bind(int descriptor) noexcept
+{
+      epoll_event l_event;
+      bool        l_poll_owner = false;
+      if(descriptor < 0) {
+          descriptor = epoll_create1(EPOLL_CLOEXEC);
+          if(descriptor < 0) {
+              return false;
+          }
+          l_poll_owner = true;
+      }
+      if(descriptor == m_poll_descriptor) {
+          return true;
+      }
+      for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+          bus_t& l_bus = m_bus_list[i_bus];
+          if(l_bus.m_descriptor >= 0) {
+              if(m_poll_descriptor >= 0) {
+                  epoll_ctl(m_poll_descriptor, EPOLL_CTL_DEL, l_bus.m_descriptor, nullptr);
+              }
+              l_event.events = l_bus.m_events;
+              l_event.data.ptr = std::addressof(l_bus);
+              if(epoll_ctl(descriptor, EPOLL_CTL_ADD, l_bus.m_descriptor, std::addressof(l_event)) < 0) {
+                  int l_descriptor = l_bus.m_descriptor;
+                  l_bus.m_descriptor = -1;
+                  l_bus.m_events = 0u;
+                  hup(l_descriptor);
+              }
+          }
+      }
+      if(m_wake_bus.m_descriptor >= 0) {
+          if(m_poll_descriptor >= 0) {
+              epoll_ctl(m_poll_descriptor, EPOLL_CTL_DEL, m_wake_bus.m_descriptor, nullptr);
+          }
+          l_event.events = m_wake_bus.m_events;
+          l_event.data.ptr = std::addressof(m_wake_bus);
+          epoll_ctl(descriptor, EPOLL_CTL_ADD, m_wake_bus.m_descriptor, std::addressof(l_event));
+      }
+      if(m_poll_owner) {
+          if(m_poll_descriptor >= 0) {
+              ::close(m_poll_descriptor);
+          }
+      }
+      m_poll_descriptor = descriptor;
+      m_poll_owner = l_poll_owner;
+      return true;
+}
+
+int   epoll::get_poll_descriptor() const noexcept
+{
+      return m_poll_descriptor;
+}
+
+/* poll()
+   wait for at most `timeout` milliseconds for activity on the poll set and dispatch it
+*/
+int   epoll::poll(int timeout) noexcept
+{
+      return dispatch(m_poll_descriptor, timeout);
+}
+
+/* dispatch()
+   wait on a (possibly shared) poll set and dispatch the ready descriptors to their owning reactors;
+   returns the number of events serviced, or -1 on error
+*/
+int   epoll::dispatch(int descriptor, int timeout) noexcept
+{
+      epoll_event l_event_list[poll_event_max];
+      int         l_event_count = epoll_wait(descriptor, l_event_list, poll_event_max, timeout);
+      if(l_event_count < 0) {
+          if(errno == EINTR) {
+              return 0;
+          }
+          return -1;
+      }
+      for(int i_event = 0; i_event < l_event_count; i_event++) {
+          bus_t* l_bus_ptr = reinterpret_cast<bus_t*>(l_event_list[i_event].data.ptr);
+          if(l_bus_ptr != nullptr) {
+              l_bus_ptr->p_owner->emi_bus_dispatch(l_bus_ptr, l_event_list[i_event].events);
+          }
+      }
+      return l_event_count;
+}
+
+/*namespace engine*/ }
+/*namespace emc*/ }
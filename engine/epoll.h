@@ -0,0 +1,107 @@
+#ifndef emc_engine_epoll_h
+#define emc_engine_epoll_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/reactor.h>
+
+namespace emc {
+namespace engine {
+
+/* epoll
+   Readiness based reactor, built on top of an edge-triggered epoll set;
+   - services the descriptors announced by the stages via event::acquire_bus and event::release_bus;
+   - drains every ready descriptor and relays the data into the pipeline in batches, via emc_raw_recv_batch();
+   - writes the messages coming out on the return path (event::send) onto their bus descriptor; whatever the descriptor
+     does not take in straight away is queued on the bus, in pool blocks, and written out as it becomes writable again;
+   - wakes up on events queued from other threads via post_async() and runs them on the polling thread.
+   Several reactors are allowed to share the same poll set, in which case a single thread can service all of them via
+   dispatch().
+*/
+class epoll: public emc::reactor
+{
+  public:
+  static constexpr int bus_count_max = 8;
+  static constexpr int poll_event_max = 64;
+  static constexpr int recv_size_min = 512;
+  static constexpr int recv_size_max = 16384;
+  static constexpr int recv_batch_max = 16;
+  static constexpr int send_queue_max = 64;
+
+  /* send_t
+     output pending on a bus: a pool block, of which [offset, size) is still to be written
+  */
+  struct send_t {
+    std::uint8_t* data;
+    std::size_t   size;
+    std::size_t   offset;
+  };
+
+  struct bus_t {
+    epoll*        p_owner;
+    int           m_descriptor;
+    unsigned int  m_events;
+    send_t        m_send_list[send_queue_max];
+    int           m_send_head;
+    int           m_send_count;
+  };
+
+  private:
+  int           m_poll_descriptor;
+  bool          m_poll_owner;
+  bus_t         m_bus_list[bus_count_max];
+  bus_t         m_wake_bus;
+  std::uint8_t  m_recv_data[recv_size_max];
+
+  protected:
+          bus_t* emi_bus_find(int) noexcept;
+          int    emi_bus_acquire(int, unsigned int) noexcept;
+          int    emi_bus_release(int) noexcept;
+          int    emi_bus_send(int, std::uint8_t*, std::size_t) noexcept;
+          bool   emi_bus_push(bus_t*, const std::uint8_t*, std::size_t) noexcept;
+          void   emi_bus_flush(bus_t*) noexcept;
+          void   emi_bus_clear(bus_t*) noexcept;
+          void   emi_bus_dispatch(bus_t*, unsigned int) noexcept;
+  virtual int    emc_raw_event(event, const event_info_t&) noexcept override;
+  virtual void   emc_raw_notify() noexcept override;
+
+  public:
+          epoll() noexcept;
+          epoll(int) noexcept;
+          epoll(const epoll&) noexcept = delete;
+          epoll(epoll&&) noexcept = delete;
+  virtual ~epoll();
+
+  virtual void   feed(int) noexcept override;
+  virtual void   hup(int) noexcept override;
+          bool   bind(int) noexcept;
+          int    get_poll_descriptor() const noexcept;
+          int    poll(int) noexcept;
+  static  int    dispatch(int, int) noexcept;
+
+          epoll& operator=(const epoll&) noexcept = delete;
+          epoll& operator=(epoll&&) noexcept = delete;
+};
+
+/*namespace engine*/ }
+/*namespace emc*/ }
+#endif
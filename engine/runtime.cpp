@@ -0,0 +1,321 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "runtime.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <ctime>
+#include <algorithm>
+#include <limits>
+
+namespace emc {
+namespace engine {
+
+      runtime::runtime(int shard_count, int balance, int tick_time, int core_base) noexcept:
+      p_shard_list(nullptr),
+      m_shard_count(0),
+      m_core_base(core_base),
+      m_balance(balance),
+      m_tick_time(tick_time),
+      m_shard_next(0),
+      m_resume_bit(false)
+{
+      epoll_event l_event;
+      if(shard_count <= 0) {
+          shard_count = std::thread::hardware_concurrency();
+          if(shard_count <= 0) {
+              shard_count = 1;
+          }
+      }
+      p_shard_list = new(std::nothrow) shard_t[shard_count];
+      if(p_shard_list != nullptr) {
+          for(int i_shard = 0; i_shard < shard_count; i_shard++) {
+              shard_t& l_shard = p_shard_list[i_shard];
+              l_shard.m_index = i_shard;
+              l_shard.m_poll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+              l_shard.m_wake_descriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+              l_shard.m_load = 0;
+              l_shard.m_pending_bit = false;
+              if((l_shard.m_poll_descriptor >= 0) &&
+                  (l_shard.m_wake_descriptor >= 0)) {
+                  // wakeups carry no bus, they are skipped by epoll::dispatch() and only interrupt the wait
+                  l_event.events = EPOLLIN | EPOLLET;
+                  l_event.data.ptr = nullptr;
+                  epoll_ctl(l_shard.m_poll_descriptor, EPOLL_CTL_ADD, l_shard.m_wake_descriptor, std::addressof(l_event));
+              }
+          }
+          m_shard_count = shard_count;
+      }
+}
+
+      runtime::~runtime()
+{
+      suspend();
+      if(p_shard_list != nullptr) {
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              shard_t& l_shard = p_shard_list[i_shard];
+              // reactors still attached are handed back their own private poll set
+              for(epoll* i_reactor : l_shard.m_reactor_list) {
+                  i_reactor->bind(-1);
+              }
+              for(epoll* i_reactor : l_shard.m_attach_list) {
+                  i_reactor->bind(-1);
+              }
+              if(l_shard.m_wake_descriptor >= 0) {
+                  ::close(l_shard.m_wake_descriptor);
+              }
+              if(l_shard.m_poll_descriptor >= 0) {
+                  ::close(l_shard.m_poll_descriptor);
+              }
+          }
+          delete[] p_shard_list;
+      }
+}
+
+void  runtime::sys_shard_run(shard_t* shard_ptr) noexcept
+{
+      timespec l_time_prev;
+      timespec l_time_next;
+      float    l_time_delta;
+      sys_shard_pin(shard_ptr);
+      clock_gettime(CLOCK_MONOTONIC, std::addressof(l_time_prev));
+      while(m_resume_bit.load(std::memory_order_acquire)) {
+          epoll::dispatch(shard_ptr->m_poll_descriptor, m_tick_time);
+          sys_shard_update(shard_ptr);
+          clock_gettime(CLOCK_MONOTONIC, std::addressof(l_time_next));
+          l_time_delta = (l_time_next.tv_sec - l_time_prev.tv_sec) + (l_time_next.tv_nsec - l_time_prev.tv_nsec) / 1e9f;
+          l_time_prev  = l_time_next;
+          sys_shard_sync(shard_ptr, l_time_delta);
+      }
+}
+
+void  runtime::sys_shard_pin(shard_t* shard_ptr) noexcept
+{
+      cpu_set_t l_cpu_set;
+      int       l_cpu_count = std::thread::hardware_concurrency();
+      if(l_cpu_count > 0) {
+          CPU_ZERO(std::addressof(l_cpu_set));
+          CPU_SET((m_core_base + shard_ptr->m_index) % l_cpu_count, std::addressof(l_cpu_set));
+          pthread_setaffinity_np(pthread_self(), sizeof(l_cpu_set), std::addressof(l_cpu_set));
+      }
+}
+
+void  runtime::sys_shard_wake(shard_t* shard_ptr) noexcept
+{
+      std::uint64_t l_value = 1u;
+      if(shard_ptr->m_wake_descriptor >= 0) {
+          if(::write(shard_ptr->m_wake_descriptor, std::addressof(l_value), sizeof(l_value)) < 0) {
+              // counter saturated: the shard has a wakeup pending already
+          }
+      }
+}
+
+/* sys_shard_update()
+   bind the newly attached reactors onto the shard's poll set and release the detached ones
+*/
+void  runtime::sys_shard_update(shard_t* shard_ptr) noexcept
+{
+      std::uint64_t l_value;
+      if(shard_ptr->m_pending_bit.load(std::memory_order_acquire)) {
+          std::unique_lock<std::mutex> l_lock(shard_ptr->m_lock);
+          shard_ptr->m_pending_bit.store(false, std::memory_order_relaxed);
+          if(shard_ptr->m_wake_descriptor >= 0) {
+              if(::read(shard_ptr->m_wake_descriptor, std::addressof(l_value), sizeof(l_value)) < 0) {
+                  // nothing to consume, the update was not triggered by a wakeup
+              }
+          }
+          for(epoll* i_reactor : shard_ptr->m_attach_list) {
+              i_reactor->bind(shard_ptr->m_poll_descriptor);
+              shard_ptr->m_reactor_list.push_back(i_reactor);
+          }
+          shard_ptr->m_attach_list.clear();
+          for(epoll* i_reactor : shard_ptr->m_detach_list) {
+              auto i_iter = std::find(shard_ptr->m_reactor_list.begin(), shard_ptr->m_reactor_list.end(), i_reactor);
+              if(i_iter != shard_ptr->m_reactor_list.end()) {
+                  *i_iter = shard_ptr->m_reactor_list.back();
+                  shard_ptr->m_reactor_list.pop_back();
+                  i_reactor->bind(-1);
+                  shard_ptr->m_load--;
+              }
+          }
+          shard_ptr->m_detach_list.clear();
+          l_lock.unlock();
+          shard_ptr->m_done.notify_all();
+      }
+}
+
+/* sys_shard_sync()
+   the reactor list is only ever modified by the shard thread itself, so it can be walked without locking
+*/
+void  runtime::sys_shard_sync(shard_t* shard_ptr, float dt) noexcept
+{
+      for(epoll* i_reactor : shard_ptr->m_reactor_list) {
+          i_reactor->sync(dt);
+      }
+}
+
+auto  runtime::sys_shard_select() noexcept -> shard_t*
+{
+      int l_shard_index = 0;
+      if(m_balance == balance_least_loaded) {
+          int l_load_min = std::numeric_limits<int>::max();
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              int l_load = p_shard_list[i_shard].m_load.load(std::memory_order_relaxed);
+              if(l_load < l_load_min) {
+                  l_load_min = l_load;
+                  l_shard_index = i_shard;
+              }
+          }
+      } else
+          l_shard_index = static_cast<unsigned int>(m_shard_next.fetch_add(1, std::memory_order_relaxed)) % m_shard_count;
+      return p_shard_list + l_shard_index;
+}
+
+/* resume()
+   start the shard threads
+*/
+bool  runtime::resume() noexcept
+{
+      if(m_resume_bit == false) {
+          if(m_shard_count == 0) {
+              return false;
+          }
+          m_resume_bit = true;
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              shard_t* l_shard_ptr = p_shard_list + i_shard;
+              try {
+                  l_shard_ptr->m_thread = std::thread(&runtime::sys_shard_run, this, l_shard_ptr);
+              } catch(...) {
+                  suspend();
+                  return false;
+              }
+          }
+      }
+      return true;
+}
+
+/* attach()
+   assign a reactor to one of the shards; returns the index of the selected shard, or -1 on failure
+*/
+int   runtime::attach(epoll* reactor_ptr) noexcept
+{
+      shard_t* l_shard_ptr;
+      if((reactor_ptr == nullptr) ||
+          (m_shard_count == 0)) {
+          return -1;
+      }
+      l_shard_ptr = sys_shard_select();
+      try {
+          std::lock_guard<std::mutex> l_lock(l_shard_ptr->m_lock);
+          l_shard_ptr->m_attach_list.push_back(reactor_ptr);
+          l_shard_ptr->m_load++;
+          l_shard_ptr->m_pending_bit.store(true, std::memory_order_release);
+      } catch(...) {
+          return -1;
+      }
+      if(m_resume_bit) {
+          sys_shard_wake(l_shard_ptr);
+      } else
+          sys_shard_update(l_shard_ptr);
+      return l_shard_ptr->m_index;
+}
+
+/* detach()
+   remove a reactor from its shard; unless called from the shard thread itself, waits for the reactor to be released
+   so that it can be safely disposed of upon return
+*/
+bool  runtime::detach(epoll* reactor_ptr) noexcept
+{
+      for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+          shard_t& l_shard = p_shard_list[i_shard];
+          try {
+              std::unique_lock<std::mutex> l_lock(l_shard.m_lock);
+              auto i_attach = std::find(l_shard.m_attach_list.begin(), l_shard.m_attach_list.end(), reactor_ptr);
+              if(i_attach != l_shard.m_attach_list.end()) {
+                  l_shard.m_attach_list.erase(i_attach);
+                  l_shard.m_load--;
+                  return true;
+              }
+              auto i_reactor = std::find(l_shard.m_reactor_list.begin(), l_shard.m_reactor_list.end(), reactor_ptr);
+              if(i_reactor != l_shard.m_reactor_list.end()) {
+                  l_shard.m_detach_list.push_back(reactor_ptr);
+                  l_shard.m_pending_bit.store(true, std::memory_order_release);
+                  if(m_resume_bit == false) {
+                      l_lock.unlock();
+                      sys_shard_update(std::addressof(l_shard));
+                  } else
+                  if(std::this_thread::get_id() != l_shard.m_thread.get_id()) {
+                      sys_shard_wake(std::addressof(l_shard));
+                      l_shard.m_done.wait(l_lock, [&]() {
+                          return std::find(l_shard.m_detach_list.begin(), l_shard.m_detach_list.end(), reactor_ptr) ==
+                              l_shard.m_detach_list.end();
+                      });
+                  }
+                  return true;
+              }
+          } catch(...) {
+              return false;
+          }
+      }
+      return false;
+}
+
+/* suspend()
+   stop the shard threads; attached reactors remain bound to their shards
+*/
+void  runtime::suspend() noexcept
+{
+      if(m_resume_bit) {
+          m_resume_bit = false;
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              sys_shard_wake(p_shard_list + i_shard);
+          }
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              if(p_shard_list[i_shard].m_thread.joinable()) {
+                  p_shard_list[i_shard].m_thread.join();
+              }
+          }
+          // apply whatever was left pending when the threads stopped
+          for(int i_shard = 0; i_shard < m_shard_count; i_shard++) {
+              sys_shard_update(p_shard_list + i_shard);
+          }
+      }
+}
+
+int   runtime::get_shard_count() const noexcept
+{
+      return m_shard_count;
+}
+
+int   runtime::get_shard_load(int index) const noexcept
+{
+      if((index >= 0) &&
+          (index < m_shard_count)) {
+          return p_shard_list[index].m_load.load(std::memory_order_relaxed);
+      }
+      return 0;
+}
+
+/*namespace engine*/ }
+/*namespace emc*/ }
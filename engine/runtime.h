@@ -0,0 +1,99 @@
+#ifndef emc_engine_runtime_h
+#define emc_engine_runtime_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include "epoll.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace emc {
+namespace engine {
+
+/* runtime
+   Drives a set of epoll reactors from N threads (shards), each pinned onto its own core;
+   - every shard owns a poll set, shared by all the reactors assigned to it, and periodically calls sync() on them;
+   - reactors are spread across the shards as they are attached, either round-robin or onto the least loaded shard;
+   - attach() and detach() are safe to call from any thread, the actual (re)binding is carried out on the shard thread;
+     once attached, a reactor is owned by its shard thread and must not be called directly from other threads.
+*/
+class runtime
+{
+  public:
+  static constexpr int balance_round_robin = 0;
+  static constexpr int balance_least_loaded = 1;
+
+  private:
+  struct shard_t {
+    int                     m_index;
+    int                     m_poll_descriptor;
+    int                     m_wake_descriptor;
+    std::thread             m_thread;
+    std::mutex              m_lock;
+    std::condition_variable m_done;
+    std::vector<epoll*>     m_reactor_list;
+    std::vector<epoll*>     m_attach_list;
+    std::vector<epoll*>     m_detach_list;
+    std::atomic<int>        m_load;
+    std::atomic<bool>       m_pending_bit;
+  };
+
+  shard_t*          p_shard_list;
+  int               m_shard_count;
+  int               m_core_base;
+  int               m_balance;
+  int               m_tick_time;
+  std::atomic<int>  m_shard_next;
+  std::atomic<bool> m_resume_bit;
+
+  private:
+          void      sys_shard_run(shard_t*) noexcept;
+          void      sys_shard_pin(shard_t*) noexcept;
+          void      sys_shard_wake(shard_t*) noexcept;
+          void      sys_shard_update(shard_t*) noexcept;
+          void      sys_shard_sync(shard_t*, float) noexcept;
+          shard_t*  sys_shard_select() noexcept;
+
+  public:
+          runtime(int = 0, int = balance_least_loaded, int = 10, int = 0) noexcept;
+          runtime(const runtime&) noexcept = delete;
+          runtime(runtime&&) noexcept = delete;
+          ~runtime();
+
+          bool      resume() noexcept;
+          int       attach(epoll*) noexcept;
+          bool      detach(epoll*) noexcept;
+          void      suspend() noexcept;
+
+          int       get_shard_count() const noexcept;
+          int       get_shard_load(int) const noexcept;
+
+          runtime&  operator=(const runtime&) noexcept = delete;
+          runtime&  operator=(runtime&&) noexcept = delete;
+};
+
+/*namespace engine*/ }
+/*namespace emc*/ }
+#endif
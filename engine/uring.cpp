@@ -0,0 +1,683 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "uring.h"
+#include <emc/error.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+
+constexpr std::uint64_t op_recv = 1u;
+constexpr std::uint64_t op_send = 2u;
+constexpr std::uint64_t op_cancel = 3u;
+constexpr std::uint64_t op_timeout = 4u;
+constexpr std::uint64_t op_wake = 5u;
+
+static inline std::uint64_t get_user_data(std::uint64_t op, int index) noexcept
+{
+      return (op << 32) | static_cast<std::uint32_t>(index);
+}
+
+namespace emc {
+namespace engine {
+
+      uring::uring() noexcept:
+      reactor(),
+      m_ring_descriptor(-1),
+      m_ring_entries(0),
+      p_sq_head(nullptr),
+      p_sq_tail(nullptr),
+      p_sq_mask(nullptr),
+      p_sq_array(nullptr),
+      p_sqe_list(nullptr),
+      m_sq_tail(0),
+      m_sq_flush(0),
+      p_cq_head(nullptr),
+      p_cq_tail(nullptr),
+      p_cq_mask(nullptr),
+      p_cqe_list(nullptr),
+      p_sq_map(nullptr),
+      m_sq_map_size(0),
+      p_cq_map(nullptr),
+      m_cq_map_size(0),
+      m_sqe_map_size(0),
+      p_buffer_map(nullptr),
+      m_buffer_map_size(0),
+      m_timeout{0, 0},
+      m_wake_descriptor(-1),
+      m_wake_count(0u),
+      m_wake_bit(false)
+{
+      static_assert(sizeof(timeout_t) == sizeof(__kernel_timespec), "timeout layout does not match the kernel's");
+      for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+          m_bus_list[i_bus].m_descriptor = -1;
+          m_bus_list[i_bus].m_recv_bit = false;
+          m_bus_list[i_bus].m_send_head = -1;
+          m_bus_list[i_bus].m_send_tail = -1;
+      }
+      for(int i_send = 0; i_send < send_count_max; i_send++) {
+          m_send_list[i_send].m_bus = -1;
+          m_send_list[i_send].m_next = -1;
+          m_send_list[i_send].m_busy_bit = false;
+          m_send_list[i_send].m_offset = 0u;
+          m_send_list[i_send].m_size = 0u;
+      }
+      if(emi_ring_setup() == false) {
+          emi_ring_dispose();
+          return;
+      }
+      // the eventfd is left blocking, so that the queued read waits for a notification instead of failing
+      m_wake_descriptor = eventfd(0, EFD_CLOEXEC);
+      if(m_wake_descriptor >= 0) {
+          emi_wake_queue();
+      }
+}
+
+      uring::~uring()
+{
+      emi_ring_dispose();
+}
+
+/* emi_ring_setup()
+   create the ring, map its queues into memory and register the buffer pool with the kernel;
+   buffers are laid out as one receive buffer per bus, followed by the send buffers
+*/
+bool  uring::emi_ring_setup() noexcept
+{
+      io_uring_params l_params;
+      iovec           l_buffer_vec;
+      std::uint8_t*   l_sq_ptr;
+      std::uint8_t*   l_cq_ptr;
+      std::memset(std::addressof(l_params), 0, sizeof(l_params));
+      m_ring_descriptor = syscall(__NR_io_uring_setup, ring_size, std::addressof(l_params));
+      if(m_ring_descriptor < 0) {
+          return false;
+      }
+      m_ring_entries = l_params.sq_entries;
+      m_sq_map_size = l_params.sq_off.array + l_params.sq_entries * sizeof(unsigned int);
+      m_cq_map_size = l_params.cq_off.cqes + l_params.cq_entries * sizeof(io_uring_cqe);
+      m_sqe_map_size = l_params.sq_entries * sizeof(io_uring_sqe);
+      if(l_params.features & IORING_FEAT_SINGLE_MMAP) {
+          if(m_cq_map_size > m_sq_map_size) {
+              m_sq_map_size = m_cq_map_size;
+          }
+          m_cq_map_size = 0;
+      }
+      p_sq_map = mmap(nullptr, m_sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_descriptor, IORING_OFF_SQ_RING);
+      if(p_sq_map == MAP_FAILED) {
+          p_sq_map = nullptr;
+          return false;
+      }
+      if(m_cq_map_size > 0) {
+          p_cq_map = mmap(nullptr, m_cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_descriptor, IORING_OFF_CQ_RING);
+          if(p_cq_map == MAP_FAILED) {
+              p_cq_map = nullptr;
+              return false;
+          }
+          l_cq_ptr = reinterpret_cast<std::uint8_t*>(p_cq_map);
+      } else
+          l_cq_ptr = reinterpret_cast<std::uint8_t*>(p_sq_map);
+      p_sqe_list = reinterpret_cast<io_uring_sqe*>(
+          mmap(nullptr, m_sqe_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_descriptor, IORING_OFF_SQES)
+      );
+      if(p_sqe_list == MAP_FAILED) {
+          p_sqe_list = nullptr;
+          return false;
+      }
+      l_sq_ptr   = reinterpret_cast<std::uint8_t*>(p_sq_map);
+      p_sq_head  = reinterpret_cast<unsigned int*>(l_sq_ptr + l_params.sq_off.head);
+      p_sq_tail  = reinterpret_cast<unsigned int*>(l_sq_ptr + l_params.sq_off.tail);
+      p_sq_mask  = reinterpret_cast<unsigned int*>(l_sq_ptr + l_params.sq_off.ring_mask);
+      p_sq_array = reinterpret_cast<unsigned int*>(l_sq_ptr + l_params.sq_off.array);
+      p_cq_head  = reinterpret_cast<unsigned int*>(l_cq_ptr + l_params.cq_off.head);
+      p_cq_tail  = reinterpret_cast<unsigned int*>(l_cq_ptr + l_params.cq_off.tail);
+      p_cq_mask  = reinterpret_cast<unsigned int*>(l_cq_ptr + l_params.cq_off.ring_mask);
+      p_cqe_list = reinterpret_cast<io_uring_cqe*>(l_cq_ptr + l_params.cq_off.cqes);
+      m_sq_tail  = *p_sq_tail;
+      m_sq_flush = m_sq_tail;
+      // allocate and register the fixed buffers
+      m_buffer_map_size = (bus_count_max + send_count_max) * buffer_size;
+      p_buffer_map = reinterpret_cast<std::uint8_t*>(
+          mmap(nullptr, m_buffer_map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+      );
+      if(p_buffer_map == MAP_FAILED) {
+          p_buffer_map = nullptr;
+          return false;
+      }
+      l_buffer_vec.iov_base = p_buffer_map;
+      l_buffer_vec.iov_len  = m_buffer_map_size;
+      if(syscall(__NR_io_uring_register, m_ring_descriptor, IORING_REGISTER_BUFFERS, std::addressof(l_buffer_vec), 1) < 0) {
+          return false;
+      }
+      return true;
+}
+
+void  uring::emi_ring_dispose() noexcept
+{
+      if(m_wake_descriptor >= 0) {
+          ::close(m_wake_descriptor);
+          m_wake_descriptor = -1;
+      }
+      if(p_buffer_map != nullptr) {
+          munmap(p_buffer_map, m_buffer_map_size);
+          p_buffer_map = nullptr;
+      }
+      if(p_sqe_list != nullptr) {
+          munmap(p_sqe_list, m_sqe_map_size);
+          p_sqe_list = nullptr;
+      }
+      if(p_cq_map != nullptr) {
+          munmap(p_cq_map, m_cq_map_size);
+          p_cq_map = nullptr;
+      }
+      if(p_sq_map != nullptr) {
+          munmap(p_sq_map, m_sq_map_size);
+          p_sq_map = nullptr;
+      }
+      if(m_ring_descriptor >= 0) {
+          ::close(m_ring_descriptor);
+          m_ring_descriptor = -1;
+      }
+}
+
+/* emi_ring_get_sqe()
+   obtain a blank submission queue entry; if the queue is full, pending entries are flushed to the kernel first
+*/
+auto  uring::emi_ring_get_sqe() noexcept -> io_uring_sqe*
+{
+      unsigned int  l_sq_head;
+      unsigned int  l_sq_index;
+      io_uring_sqe* l_sqe_ptr;
+      if(m_ring_descriptor < 0) {
+          return nullptr;
+      }
+      l_sq_head = __atomic_load_n(p_sq_head, __ATOMIC_ACQUIRE);
+      if(m_sq_tail - l_sq_head >= m_ring_entries) {
+          emi_ring_submit(0);
+          l_sq_head = __atomic_load_n(p_sq_head, __ATOMIC_ACQUIRE);
+          if(m_sq_tail - l_sq_head >= m_ring_entries) {
+              return nullptr;
+          }
+      }
+      l_sq_index = m_sq_tail & *p_sq_mask;
+      l_sqe_ptr  = p_sqe_list + l_sq_index;
+      std::memset(l_sqe_ptr, 0, sizeof(io_uring_sqe));
+      p_sq_array[l_sq_index] = l_sq_index;
+      m_sq_tail++;
+      return l_sqe_ptr;
+}
+
+/* emi_ring_submit()
+   flush the queued entries to the kernel and, optionally, wait for the given number of completions
+*/
+int   uring::emi_ring_submit(unsigned int wait_count) noexcept
+{
+      unsigned int l_submit_count = m_sq_tail - m_sq_flush;
+      unsigned int l_enter_flags  = 0u;
+      int          l_result;
+      if((l_submit_count == 0u) &&
+          (wait_count == 0u)) {
+          return 0;
+      }
+      if(wait_count > 0u) {
+          l_enter_flags |= IORING_ENTER_GETEVENTS;
+      }
+      __atomic_store_n(p_sq_tail, m_sq_tail, __ATOMIC_RELEASE);
+      l_result = syscall(__NR_io_uring_enter, m_ring_descriptor, l_submit_count, wait_count, l_enter_flags, nullptr, 0);
+      if(l_result < 0) {
+          if((errno == EINTR) ||
+              (errno == EAGAIN) ||
+              (errno == EBUSY)) {
+              return 0;
+          }
+          return -1;
+      }
+      m_sq_flush += l_result;
+      return l_result;
+}
+
+/* emi_ring_reap()
+   consume all the available completions; returns the number of completions processed
+*/
+int   uring::emi_ring_reap() noexcept
+{
+      unsigned int  l_cq_head = *p_cq_head;
+      unsigned int  l_cq_tail = __atomic_load_n(p_cq_tail, __ATOMIC_ACQUIRE);
+      std::uint64_t l_user_data;
+      int           l_user_result;
+      int           l_count = 0;
+      while(l_cq_head != l_cq_tail) {
+          io_uring_cqe* l_cqe_ptr = p_cqe_list + (l_cq_head & *p_cq_mask);
+          l_user_data   = l_cqe_ptr->user_data;
+          l_user_result = l_cqe_ptr->res;
+          // release the entry before handling it, handlers may re-enter the ring
+          __atomic_store_n(p_cq_head, ++l_cq_head, __ATOMIC_RELEASE);
+          emi_ring_complete(l_user_data, l_user_result);
+          l_cq_head = *p_cq_head;
+          l_cq_tail = __atomic_load_n(p_cq_tail, __ATOMIC_ACQUIRE);
+          l_count++;
+      }
+      return l_count;
+}
+
+void  uring::emi_ring_complete(std::uint64_t user_data, int result) noexcept
+{
+      std::uint64_t l_op    = user_data >> 32;
+      int           l_index = static_cast<int>(user_data & 0xffffffffu);
+      if(l_op == op_wake) {
+          m_wake_bit = false;
+          if(result > 0) {
+              pod_drain_queue();
+          }
+          if((result > 0) ||
+              (result == -EINTR) ||
+              (result == -EAGAIN)) {
+              if(m_wake_bit == false) {
+                  emi_wake_queue();
+              }
+          }
+      } else
+      if(l_op == op_recv) {
+          bus_t& l_bus = m_bus_list[l_index];
+          int    l_descriptor = l_bus.m_descriptor;
+          l_bus.m_recv_bit = false;
+          if(l_descriptor >= 0) {
+              if(result > 0) {
+                  pod_recv(l_descriptor, emi_recv_data(l_index), result);
+                  // the bus may have been released or the read requeued while processing the message
+                  if((l_bus.m_descriptor == l_descriptor) &&
+                      (l_bus.m_recv_bit == false)) {
+                      emi_recv_queue(l_index);
+                  }
+              } else
+              if((result == -EINTR) ||
+                  (result == -EAGAIN)) {
+                  emi_recv_queue(l_index);
+              } else
+                  hup(l_descriptor);
+          }
+      } else
+      if(l_op == op_send) {
+          send_t& l_send = m_send_list[l_index];
+          bus_t&  l_bus  = m_bus_list[l_send.m_bus];
+          l_send.m_busy_bit = false;
+          if(l_bus.m_descriptor >= 0) {
+              if(result > 0) {
+                  l_send.m_offset += result;
+                  if(l_send.m_offset < l_send.m_size) {
+                      emi_send_queue(l_index);
+                      return;
+                  }
+              } else
+              if((result == -EINTR) ||
+                  (result == -EAGAIN)) {
+                  emi_send_queue(l_index);
+                  return;
+              } else
+              {
+                  hup(l_bus.m_descriptor);
+                  return;
+              }
+              l_bus.m_send_head = l_send.m_next;
+              if(l_bus.m_send_head < 0) {
+                  l_bus.m_send_tail = -1;
+              }
+              emi_send_dispose(l_index);
+              if(l_bus.m_send_head >= 0) {
+                  emi_send_queue(l_bus.m_send_head);
+              }
+          } else
+          {
+              // bus was released while the write was in flight; it is the last entry left in its queue
+              l_bus.m_send_head = -1;
+              l_bus.m_send_tail = -1;
+              emi_send_dispose(l_index);
+          }
+      }
+}
+
+auto  uring::emi_recv_data(int bus_index) noexcept -> std::uint8_t*
+{
+      return p_buffer_map + bus_index * buffer_size;
+}
+
+auto  uring::emi_send_data(int send_index) noexcept -> std::uint8_t*
+{
+      return p_buffer_map + (bus_count_max + send_index) * buffer_size;
+}
+
+bool  uring::emi_recv_queue(int bus_index) noexcept
+{
+      io_uring_sqe* l_sqe_ptr = emi_ring_get_sqe();
+      if(l_sqe_ptr != nullptr) {
+          l_sqe_ptr->opcode    = IORING_OP_READ_FIXED;
+          l_sqe_ptr->fd        = m_bus_list[bus_index].m_descriptor;
+          l_sqe_ptr->addr      = reinterpret_cast<std::uint64_t>(emi_recv_data(bus_index));
+          l_sqe_ptr->len       = buffer_size;
+          l_sqe_ptr->off       = static_cast<std::uint64_t>(-1);
+          l_sqe_ptr->buf_index = 0;
+          l_sqe_ptr->user_data = get_user_data(op_recv, bus_index);
+          m_bus_list[bus_index].m_recv_bit = true;
+          return true;
+      }
+      return false;
+}
+
+bool  uring::emi_send_queue(int send_index) noexcept
+{
+      send_t&       l_send = m_send_list[send_index];
+      io_uring_sqe* l_sqe_ptr = emi_ring_get_sqe();
+      if(l_sqe_ptr != nullptr) {
+          l_sqe_ptr->opcode    = IORING_OP_WRITE_FIXED;
+          l_sqe_ptr->fd        = m_bus_list[l_send.m_bus].m_descriptor;
+          l_sqe_ptr->addr      = reinterpret_cast<std::uint64_t>(emi_send_data(send_index) + l_send.m_offset);
+          l_sqe_ptr->len       = l_send.m_size - l_send.m_offset;
+          l_sqe_ptr->off       = static_cast<std::uint64_t>(-1);
+          l_sqe_ptr->buf_index = 0;
+          l_sqe_ptr->user_data = get_user_data(op_send, send_index);
+          l_send.m_busy_bit = true;
+          return true;
+      }
+      return false;
+}
+
+bool  uring::emi_wake_queue() noexcept
+{
+      io_uring_sqe* l_sqe_ptr = emi_ring_get_sqe();
+      if(l_sqe_ptr != nullptr) {
+          l_sqe_ptr->opcode    = IORING_OP_READ;
+          l_sqe_ptr->fd        = m_wake_descriptor;
+          l_sqe_ptr->addr      = reinterpret_cast<std::uint64_t>(std::addressof(m_wake_count));
+          l_sqe_ptr->len       = sizeof(m_wake_count);
+          l_sqe_ptr->user_data = get_user_data(op_wake, 0);
+          m_wake_bit = true;
+          return true;
+      }
+      return false;
+}
+
+/* emi_send_reserve()
+   find a free send buffer
+*/
+int   uring::emi_send_reserve() noexcept
+{
+      for(int i_send = 0; i_send < send_count_max; i_send++) {
+          if(m_send_list[i_send].m_bus < 0) {
+              return i_send;
+          }
+      }
+      return -1;
+}
+
+void  uring::emi_send_dispose(int send_index) noexcept
+{
+      m_send_list[send_index].m_bus = -1;
+      m_send_list[send_index].m_next = -1;
+      m_send_list[send_index].m_busy_bit = false;
+      m_send_list[send_index].m_offset = 0u;
+      m_send_list[send_index].m_size = 0u;
+}
+
+int   uring::emi_bus_find(int descriptor) noexcept
+{
+      if(descriptor >= 0) {
+          for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+              if(m_bus_list[i_bus].m_descriptor == descriptor) {
+                  return i_bus;
+              }
+          }
+      }
+      return -1;
+}
+
+/* emi_bus_acquire()
+   start servicing a bus descriptor; the event mask is not relevant to this engine, the descriptor is always read from
+*/
+int   uring::emi_bus_acquire(int descriptor, unsigned int) noexcept
+{
+      if((descriptor < 0) ||
+          (m_ring_descriptor < 0)) {
+          return err_fail;
+      }
+      if(emi_bus_find(descriptor) >= 0) {
+          return err_okay;
+      }
+      for(int i_bus = 0; i_bus < bus_count_max; i_bus++) {
+          bus_t& l_bus = m_bus_list[i_bus];
+          // slots which still have operations in flight from a previous descriptor are not reusable yet
+          if((l_bus.m_descriptor < 0) &&
+              (l_bus.m_recv_bit == false) &&
+              (l_bus.m_send_head < 0)) {
+              l_bus.m_descriptor = descriptor;
+              if(emi_recv_queue(i_bus) == false) {
+                  l_bus.m_descriptor = -1;
+                  return err_fail;
+              }
+              return err_okay;
+          }
+      }
+      return err_fail;
+}
+
+/* emi_bus_release()
+   stop servicing a bus descriptor: cancel the operations in flight and drop the pending writes
+*/
+int   uring::emi_bus_release(int descriptor) noexcept
+{
+      io_uring_sqe* l_sqe_ptr;
+      int           l_bus_index = emi_bus_find(descriptor);
+      int           i_send;
+      if(l_bus_index >= 0) {
+          bus_t& l_bus = m_bus_list[l_bus_index];
+          if(l_bus.m_recv_bit) {
+              l_sqe_ptr = emi_ring_get_sqe();
+              if(l_sqe_ptr != nullptr) {
+                  l_sqe_ptr->opcode    = IORING_OP_ASYNC_CANCEL;
+                  l_sqe_ptr->fd        = -1;
+                  l_sqe_ptr->addr      = get_user_data(op_recv, l_bus_index);
+                  l_sqe_ptr->user_data = get_user_data(op_cancel, l_bus_index);
+              }
+          }
+          i_send = l_bus.m_send_head;
+          l_bus.m_send_head = -1;
+          l_bus.m_send_tail = -1;
+          while(i_send >= 0) {
+              int l_send_next = m_send_list[i_send].m_next;
+              if(m_send_list[i_send].m_busy_bit) {
+                  l_sqe_ptr = emi_ring_get_sqe();
+                  if(l_sqe_ptr != nullptr) {
+                      l_sqe_ptr->opcode    = IORING_OP_ASYNC_CANCEL;
+                      l_sqe_ptr->fd        = -1;
+                      l_sqe_ptr->addr      = get_user_data(op_send, i_send);
+                      l_sqe_ptr->user_data = get_user_data(op_cancel, i_send);
+                  }
+                  m_send_list[i_send].m_next = -1;
+                  l_bus.m_send_head = i_send;
+                  l_bus.m_send_tail = i_send;
+              } else
+                  emi_send_dispose(i_send);
+              i_send = l_send_next;
+          }
+          l_bus.m_descriptor = -1;
+          // flush the cancellations right away: the stage is likely about to close the descriptor
+          emi_ring_submit(0);
+          return err_okay;
+      }
+      return err_not_required;
+}
+
+/* emi_bus_send()
+   copy a message into the send buffers and queue it for writing onto its bus, after any writes still pending on it;
+   the message is refused, rather than waited for, if the bus is not known to the engine or if there are not enough free
+   buffers left to hold all of it: this runs on the reactor thread, which must not block on a peer that stopped reading
+*/
+int   uring::emi_bus_send(int descriptor, std::uint8_t* data, std::size_t size) noexcept
+{
+      int         l_bus_index = emi_bus_find(descriptor);
+      int         l_free_count = 0;
+      int         l_need_count;
+      int         l_send_index;
+      std::size_t l_copy_size;
+      if(l_bus_index < 0) {
+          return err_fail;
+      }
+      l_need_count = (size + buffer_size - 1) / buffer_size;
+      for(int i_send = 0; i_send < send_count_max; i_send++) {
+          if(m_send_list[i_send].m_bus < 0) {
+              l_free_count++;
+          }
+      }
+      // queue either the whole message or none of it, so that a retry does not end up with a torn message on the wire
+      if(l_need_count > l_free_count) {
+          return err_fail;
+      }
+      while(size > 0) {
+          bus_t& l_bus = m_bus_list[l_bus_index];
+          l_send_index = emi_send_reserve();
+          l_copy_size  = size;
+          if(l_copy_size > static_cast<std::size_t>(buffer_size)) {
+              l_copy_size = buffer_size;
+          }
+          std::memcpy(emi_send_data(l_send_index), data, l_copy_size);
+          send_t& l_send = m_send_list[l_send_index];
+          l_send.m_bus = l_bus_index;
+          l_send.m_next = -1;
+          l_send.m_busy_bit = false;
+          l_send.m_offset = 0u;
+          l_send.m_size = l_copy_size;
+          if(l_bus.m_send_tail >= 0) {
+              m_send_list[l_bus.m_send_tail].m_next = l_send_index;
+          } else
+              l_bus.m_send_head = l_send_index;
+          l_bus.m_send_tail = l_send_index;
+          if(l_bus.m_send_head == l_send_index) {
+              if(emi_send_queue(l_send_index) == false) {
+                  // no submission entry for the write: take the slot back out of the queue, otherwise it would sit at
+                  // the head with nothing in flight and block every later send on this bus
+                  l_bus.m_send_head = -1;
+                  l_bus.m_send_tail = -1;
+                  emi_send_dispose(l_send_index);
+                  return err_fail;
+              }
+          }
+          data += l_copy_size;
+          size -= l_copy_size;
+      }
+      return err_okay;
+}
+
+int   uring::emc_raw_event(event id, const event_info_t& info) noexcept
+{
+      switch(id) {
+        case event::acquire_bus:
+            return emi_bus_acquire(info.acquire_bus.descriptor, info.acquire_bus.events);
+        case event::release_bus:
+            return emi_bus_release(info.release_bus.descriptor);
+        case event::feed:
+            feed(info.feed.descriptor);
+            return err_okay;
+        case event::send:
+            return emi_bus_send(info.send.bus, info.send.data, info.send.size);
+        default:
+            break;
+      }
+      return reactor::emc_raw_event(id, info);
+}
+
+void  uring::emc_raw_notify() noexcept
+{
+      std::uint64_t l_wake_count = 1u;
+      if(m_wake_descriptor >= 0) {
+          if(::write(m_wake_descriptor, std::addressof(l_wake_count), sizeof(l_wake_count)) < 0) {
+              // counter saturated: a wakeup is pending already
+          }
+      }
+}
+
+/* feed()
+   reads are kept queued on every bus at all times, so all there is to do is to requeue the read if it had been
+   interrupted
+*/
+void  uring::feed(int descriptor) noexcept
+{
+      int l_bus_index = emi_bus_find(descriptor);
+      if(l_bus_index >= 0) {
+          if(m_bus_list[l_bus_index].m_recv_bit == false) {
+              emi_recv_queue(l_bus_index);
+          }
+      }
+}
+
+/* hup()
+   stop servicing the descriptor and notify the pipeline
+*/
+void  uring::hup(int descriptor) noexcept
+{
+      emi_bus_release(descriptor);
+      post(event::hup, event_info_t::for_hup(descriptor));
+}
+
+bool  uring::is_ready() const noexcept
+{
+      return m_ring_descriptor >= 0;
+}
+
+/* poll()
+   flush the pending submissions, wait for at most `timeout` milliseconds (indefinitely if negative) for at least one
+   completion and process all the completions available; returns the number of completions processed, or -1 on error
+*/
+int   uring::poll(int timeout) noexcept
+{
+      unsigned int l_wait_count = 0u;
+      if(m_ring_descriptor < 0) {
+          return -1;
+      }
+      if(timeout != 0) {
+          if(*p_cq_head == __atomic_load_n(p_cq_tail, __ATOMIC_ACQUIRE)) {
+              if(timeout > 0) {
+                  // the timeout completes either on expiry or as soon as any other operation completes
+                  io_uring_sqe* l_sqe_ptr = emi_ring_get_sqe();
+                  if(l_sqe_ptr != nullptr) {
+                      m_timeout.tv_sec  = timeout / 1000;
+                      m_timeout.tv_nsec = (timeout % 1000) * 1000000;
+                      l_sqe_ptr->opcode    = IORING_OP_TIMEOUT;
+                      l_sqe_ptr->fd        = -1;
+                      l_sqe_ptr->addr      = reinterpret_cast<std::uint64_t>(std::addressof(m_timeout));
+                      l_sqe_ptr->len       = 1;
+                      l_sqe_ptr->off       = 1;
+                      l_sqe_ptr->user_data = get_user_data(op_timeout, 0);
+                  }
+              }
+              l_wait_count = 1u;
+          }
+      }
+      if(emi_ring_submit(l_wait_count) < 0) {
+          return -1;
+      }
+      return emi_ring_reap();
+}
+
+/*namespace engine*/ }
+/*namespace emc*/ }
@@ -0,0 +1,140 @@
+#ifndef emc_engine_uring_h
+#define emc_engine_uring_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/reactor.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace emc {
+namespace engine {
+
+/* uring
+   Completion based reactor, built on top of io_uring;
+   - keeps a read permanently queued on every descriptor announced via event::acquire_bus, into a registered (fixed)
+     buffer, and relays the completed reads into the pipeline, via emc_raw_recv();
+   - copies the messages coming out on the return path (event::send) into registered buffers and queues them for
+     writing; writes to the same bus are kept in order;
+   - keeps a read queued on an eventfd, to wake up on events queued from other threads via post_async();
+   - submissions are batched and only flushed to the kernel once per poll(), so that a loop iteration costs a couple of
+     system calls regardless of the number of messages.
+   Stage callbacks are invoked exactly as with the readiness based engine.
+*/
+class uring: public emc::reactor
+{
+  public:
+  static constexpr int bus_count_max = 8;
+  static constexpr int send_count_max = 16;
+  static constexpr int buffer_size = 4096;
+  static constexpr int ring_size = 64;
+
+  private:
+  struct bus_t {
+    int           m_descriptor;
+    bool          m_recv_bit;       // read queued in the ring
+    short int     m_send_head;      // first queued send slot, or -1
+    short int     m_send_tail;      // last queued send slot, or -1
+  };
+
+  struct send_t {
+    int           m_bus;            // owning bus slot, or -1 if free
+    short int     m_next;
+    bool          m_busy_bit;       // write queued in the ring
+    unsigned int  m_offset;
+    unsigned int  m_size;
+  };
+
+  struct timeout_t {
+    long long int tv_sec;
+    long long int tv_nsec;
+  };
+
+  int           m_ring_descriptor;
+  unsigned int  m_ring_entries;
+  unsigned int* p_sq_head;
+  unsigned int* p_sq_tail;
+  unsigned int* p_sq_mask;
+  unsigned int* p_sq_array;
+  io_uring_sqe* p_sqe_list;
+  unsigned int  m_sq_tail;
+  unsigned int  m_sq_flush;
+  unsigned int* p_cq_head;
+  unsigned int* p_cq_tail;
+  unsigned int* p_cq_mask;
+  io_uring_cqe* p_cqe_list;
+  void*         p_sq_map;
+  std::size_t   m_sq_map_size;
+  void*         p_cq_map;
+  std::size_t   m_cq_map_size;
+  std::size_t   m_sqe_map_size;
+  std::uint8_t* p_buffer_map;
+  std::size_t   m_buffer_map_size;
+  timeout_t     m_timeout;
+  int           m_wake_descriptor;
+  std::uint64_t m_wake_count;
+  bool          m_wake_bit;
+  bus_t         m_bus_list[bus_count_max];
+  send_t        m_send_list[send_count_max];
+
+  private:
+          bool   emi_ring_setup() noexcept;
+          void   emi_ring_dispose() noexcept;
+          auto   emi_ring_get_sqe() noexcept -> io_uring_sqe*;
+          int    emi_ring_submit(unsigned int) noexcept;
+          int    emi_ring_reap() noexcept;
+          void   emi_ring_complete(std::uint64_t, int) noexcept;
+          auto   emi_recv_data(int) noexcept -> std::uint8_t*;
+          auto   emi_send_data(int) noexcept -> std::uint8_t*;
+          bool   emi_recv_queue(int) noexcept;
+          bool   emi_send_queue(int) noexcept;
+          bool   emi_wake_queue() noexcept;
+          int    emi_send_reserve() noexcept;
+          void   emi_send_dispose(int) noexcept;
+
+  protected:
+          int    emi_bus_find(int) noexcept;
+          int    emi_bus_acquire(int, unsigned int) noexcept;
+          int    emi_bus_release(int) noexcept;
+          int    emi_bus_send(int, std::uint8_t*, std::size_t) noexcept;
+  virtual int    emc_raw_event(event, const event_info_t&) noexcept override;
+  virtual void   emc_raw_notify() noexcept override;
+
+  public:
+          uring() noexcept;
+          uring(const uring&) noexcept = delete;
+          uring(uring&&) noexcept = delete;
+  virtual ~uring();
+
+  virtual void   feed(int) noexcept override;
+  virtual void   hup(int) noexcept override;
+          bool   is_ready() const noexcept;
+          int    poll(int) noexcept;
+
+          uring& operator=(const uring&) noexcept = delete;
+          uring& operator=(uring&&) noexcept = delete;
+};
+
+/*namespace engine*/ }
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,109 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "arena.h"
+#include <cstdlib>
+
+namespace emc {
+
+      arena::arena() noexcept:
+      p_data(nullptr),
+      m_size(0),
+      m_used(0)
+{
+}
+
+      arena::~arena()
+{
+      dispose();
+}
+
+/* reserve()
+   allocate the backing storage; the arena does not grow past this size afterwards
+*/
+bool  arena::reserve(std::size_t size) noexcept
+{
+      if(size > m_size) {
+          void* l_data_ptr = std::realloc(p_data, size);
+          if(l_data_ptr == nullptr) {
+              return false;
+          }
+          p_data = reinterpret_cast<std::uint8_t*>(l_data_ptr);
+          m_size = size;
+      }
+      return true;
+}
+
+void  arena::dispose() noexcept
+{
+      if(p_data != nullptr) {
+          std::free(p_data);
+          p_data = nullptr;
+      }
+      m_size = 0;
+      m_used = 0;
+}
+
+/* get()
+   carve `size` bytes off the arena, aligned to `align` (a power of two); returns nullptr when the arena is exhausted
+*/
+std::uint8_t* arena::get(std::size_t size, std::size_t align) noexcept
+{
+      std::size_t l_offset = (m_used + align - 1) & ~(align - 1);
+      if((l_offset <= m_size) &&
+          (size <= m_size - l_offset)) {
+          m_used = l_offset + size;
+          return p_data + l_offset;
+      }
+      return nullptr;
+}
+
+/* get_mark()
+   save the current allocation point, to be able to roll back a set of allocations via set_mark()
+*/
+std::size_t arena::get_mark() const noexcept
+{
+      return m_used;
+}
+
+void  arena::set_mark(std::size_t mark) noexcept
+{
+      if(mark < m_used) {
+          m_used = mark;
+      }
+}
+
+std::size_t arena::get_used() const noexcept
+{
+      return m_used;
+}
+
+std::size_t arena::get_size() const noexcept
+{
+      return m_size;
+}
+
+void  arena::reset() noexcept
+{
+      m_used = 0;
+}
+
+/*namespace emc*/ }
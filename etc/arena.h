@@ -0,0 +1,58 @@
+#ifndef emc_arena_h
+#define emc_arena_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+
+namespace emc {
+
+/* arena
+   fixed capacity bump allocator for scratch memory that only needs to live for the duration of one dispatch;
+   individual allocations are never freed, the whole arena is rewound at once via reset()
+*/
+class arena
+{
+  std::uint8_t*   p_data;
+  std::size_t     m_size;
+  std::size_t     m_used;
+
+  public:
+          arena() noexcept;
+          arena(const arena&) noexcept = delete;
+          arena(arena&&) noexcept = delete;
+          ~arena();
+
+          bool          reserve(std::size_t) noexcept;
+          void          dispose() noexcept;
+          std::uint8_t* get(std::size_t, std::size_t = alignof(std::max_align_t)) noexcept;
+          std::size_t   get_mark() const noexcept;
+          void          set_mark(std::size_t) noexcept;
+          std::size_t   get_used() const noexcept;
+          std::size_t   get_size() const noexcept;
+          void          reset() noexcept;
+
+          arena&        operator=(const arena&) noexcept = delete;
+          arena&        operator=(arena&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,260 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "dispatch.h"
+#include <algorithm>
+#include <cstring>
+
+namespace emc {
+
+static constexpr std::uint64_t s_seed_base = 0x9e3779b97f4a7c15ull;
+static constexpr int s_seed_count_max = 16;
+static constexpr unsigned int s_displace_max = 0xffffu;
+
+static inline std::uint64_t emi_mix(std::uint64_t value) noexcept {
+      value ^= value >> 33;
+      value *= 0xff51afd7ed558ccdull;
+      value ^= value >> 33;
+      value *= 0xc4ceb9fe1a85ec53ull;
+      value ^= value >> 33;
+      return value;
+}
+
+      dispatch::dispatch() noexcept:
+      m_seed(s_seed_base),
+      m_entry_count(0),
+      m_slot_mask(0u),
+      m_bucket_mask(0u),
+      m_ready_bit(false)
+{
+}
+
+      dispatch::~dispatch()
+{
+}
+
+/* emi_get_hash()
+   64 bit hash of the name: 8 bytes at a time folded with a multiply-rotate, then a single avalanche at the end; names
+   are short, so this is a handful of multiplications per lookup
+*/
+std::uint64_t dispatch::emi_get_hash(std::uint64_t seed, const char* name, std::size_t size) noexcept
+{
+      std::uint64_t l_hash = seed ^ (size * 0x100000001b3ull);
+      std::uint64_t l_word;
+      while(size >= sizeof(l_word)) {
+          std::memcpy(std::addressof(l_word), name, sizeof(l_word));
+          l_hash = (l_hash ^ l_word) * 0x87c37b91114253d5ull;
+          l_hash = (l_hash << 31) | (l_hash >> 33);
+          name += sizeof(l_word);
+          size -= sizeof(l_word);
+      }
+      if(size) {
+          l_word = 0u;
+          std::memcpy(std::addressof(l_word), name, size);
+          l_hash = (l_hash ^ l_word) * 0x87c37b91114253d5ull;
+      }
+      return emi_mix(l_hash);
+}
+
+/* emi_get_slot()
+   slot of a key with the given hash once its bucket has been displaced by <displace>
+*/
+unsigned int dispatch::emi_get_slot(std::uint64_t hash, unsigned int displace, unsigned int mask) noexcept
+{
+      return (((hash ^ (displace * s_seed_base)) * 0xff51afd7ed558ccdull) >> 32) & mask;
+}
+
+/* emi_place()
+   try to build the table with the given seed; fails if two distinct names happen to share a hash, or if a bucket
+   can not be displaced into free slots
+*/
+bool  dispatch::emi_place(std::uint64_t seed) noexcept
+{
+      std::uint16_t l_order_list[entry_count_max];
+      std::uint16_t l_bucket_base[bucket_count_max + 1];
+      std::uint16_t l_bucket_list[bucket_count_max];
+      unsigned int  l_bucket_count = m_bucket_mask + 1u;
+
+      // hash the names and count the keys falling into each bucket
+      std::memset(l_bucket_base, 0, sizeof(l_bucket_base));
+      for(int i_entry = 0; i_entry < m_entry_count; i_entry++) {
+          entry_t& l_entry = m_entry_list[i_entry];
+          l_entry.hash = emi_get_hash(seed, l_entry.name, l_entry.size);
+          l_bucket_base[((l_entry.hash >> 40) & m_bucket_mask) + 1]++;
+      }
+
+      // group the keys by bucket
+      for(unsigned int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          l_bucket_base[i_bucket + 1] += l_bucket_base[i_bucket];
+          l_bucket_list[i_bucket] = i_bucket;
+      }
+      {
+          std::uint16_t l_fill_list[bucket_count_max];
+          std::memcpy(l_fill_list, l_bucket_base, sizeof(l_fill_list));
+          for(int i_entry = 0; i_entry < m_entry_count; i_entry++) {
+              unsigned int l_bucket = (m_entry_list[i_entry].hash >> 40) & m_bucket_mask;
+              l_order_list[l_fill_list[l_bucket]++] = i_entry;
+          }
+      }
+
+      // place the largest buckets first, while there is the most room left
+      std::sort(
+          l_bucket_list,
+          l_bucket_list + l_bucket_count,
+          [&](std::uint16_t lhs, std::uint16_t rhs) {
+              return l_bucket_base[lhs + 1] - l_bucket_base[lhs] > l_bucket_base[rhs + 1] - l_bucket_base[rhs];
+          }
+      );
+
+      std::memset(m_slot_list, 0xff, sizeof(m_slot_list));
+      for(unsigned int i_bucket = 0; i_bucket < l_bucket_count; i_bucket++) {
+          unsigned int   l_bucket = l_bucket_list[i_bucket];
+          std::uint16_t* l_key_base = l_order_list + l_bucket_base[l_bucket];
+          int            l_key_count = l_bucket_base[l_bucket + 1] - l_bucket_base[l_bucket];
+          unsigned int   l_slot_list[entry_count_max];
+          unsigned int   l_displace = 0u;
+          if(l_key_count == 0) {
+              m_bucket_list[l_bucket] = 0u;
+              continue;
+          }
+          while(true) {
+              int l_key_index = 0;
+              while(l_key_index < l_key_count) {
+                  unsigned int l_slot = emi_get_slot(m_entry_list[l_key_base[l_key_index]].hash, l_displace, m_slot_mask);
+                  if(m_slot_list[l_slot] != slot_none) {
+                      break;
+                  }
+                  // reserve the slot so that two keys of the same bucket can not land on it
+                  m_slot_list[l_slot] = l_key_base[l_key_index];
+                  l_slot_list[l_key_index] = l_slot;
+                  l_key_index++;
+              }
+              if(l_key_index == l_key_count) {
+                  break;
+              }
+              for(int i_key = 0; i_key < l_key_index; i_key++) {
+                  m_slot_list[l_slot_list[i_key]] = slot_none;
+              }
+              if(l_displace == s_displace_max) {
+                  return false;
+              }
+              l_displace++;
+          }
+          m_bucket_list[l_bucket] = l_displace;
+      }
+      m_seed = seed;
+      return true;
+}
+
+/* insert()
+   add a name to the table; the table needs to be rebuilt before the name can be found
+*/
+bool  dispatch::insert(const char* name, stage* stage_ptr, int index) noexcept
+{
+      if(name == nullptr) {
+          return false;
+      }
+      if(m_entry_count >= entry_count_max) {
+          return false;
+      }
+      std::size_t l_size = std::strlen(name);
+      for(int i_entry = 0; i_entry < m_entry_count; i_entry++) {
+          const entry_t& l_entry = m_entry_list[i_entry];
+          if(l_entry.size == l_size) {
+              if(std::memcmp(l_entry.name, name, l_size) == 0) {
+                  return false;
+              }
+          }
+      }
+      entry_t& l_entry = m_entry_list[m_entry_count++];
+      l_entry.name = name;
+      l_entry.size = l_size;
+      l_entry.hash = 0u;
+      l_entry.stage_ptr = stage_ptr;
+      l_entry.index = index;
+      m_ready_bit = false;
+      return true;
+}
+
+/* build()
+   compute the perfect hash over the names inserted so far
+*/
+bool  dispatch::build() noexcept
+{
+      unsigned int l_slot_count = 8u;
+      while(l_slot_count < static_cast<unsigned int>(m_entry_count) * 2u) {
+          l_slot_count <<= 1;
+      }
+      m_slot_mask = l_slot_count - 1u;
+      m_bucket_mask = l_slot_count / 4u - 1u;
+      m_ready_bit = false;
+      for(int i_seed = 0; i_seed < s_seed_count_max; i_seed++) {
+          if(emi_place(emi_mix(s_seed_base + i_seed))) {
+              m_ready_bit = true;
+              return true;
+          }
+      }
+      return false;
+}
+
+/* find()
+   lookup a name and return the entry for it, or nullptr if the name is not in the table
+*/
+auto  dispatch::find(const char* name, std::size_t size) const noexcept -> const entry_t*
+{
+      if(m_ready_bit) {
+          std::uint64_t l_hash = emi_get_hash(m_seed, name, size);
+          unsigned int  l_slot = emi_get_slot(l_hash, m_bucket_list[(l_hash >> 40) & m_bucket_mask], m_slot_mask);
+          std::uint16_t l_index = m_slot_list[l_slot];
+          if(l_index != slot_none) {
+              const entry_t& l_entry = m_entry_list[l_index];
+              if(l_entry.hash == l_hash) {
+                  if(l_entry.size == size) {
+                      if(std::memcmp(l_entry.name, name, size) == 0) {
+                          return std::addressof(l_entry);
+                      }
+                  }
+              }
+          }
+      }
+      return nullptr;
+}
+
+auto  dispatch::find(const char* name) const noexcept -> const entry_t*
+{
+      if(name) {
+          return find(name, std::strlen(name));
+      }
+      return nullptr;
+}
+
+int   dispatch::get_count() const noexcept
+{
+      return m_entry_count;
+}
+
+void  dispatch::clear() noexcept
+{
+      m_entry_count = 0;
+      m_ready_bit = false;
+}
+
+/*namespace emc*/ }
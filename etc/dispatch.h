@@ -0,0 +1,89 @@
+#ifndef emc_dispatch_h
+#define emc_dispatch_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+
+namespace emc {
+
+/* dispatch
+   perfect hash table mapping names onto the stage serving them (and the index of the name within the stage), built
+   with the hash and displace method: the keys are hashed once, spread into buckets, and each bucket, largest first,
+   is assigned the smallest displacement that moves all of its keys into free slots; a lookup is one hash of the key,
+   one displacement and one slot, then a single string compare to reject names which aren't in the table;
+   - the names are not copied, they need to remain valid until the table is cleared or rebuilt;
+   - building is meant to happen off the hot path (when stages are attached, detached or resumed) and does not
+     allocate; lookups don't either;
+   - if the same name is inserted twice, the first one wins.
+*/
+class dispatch
+{
+  public:
+  static constexpr int entry_count_max = 256;
+  static constexpr int slot_count_max = entry_count_max * 2;
+  static constexpr int bucket_count_max = slot_count_max / 4;
+
+  struct entry_t {
+    const char*   name;
+    std::size_t   size;
+    std::uint64_t hash;
+    stage*        stage_ptr;
+    int           index;
+  };
+
+  private:
+  static constexpr std::uint16_t slot_none = 0xffff;
+
+  private:
+  entry_t         m_entry_list[entry_count_max];
+  std::uint16_t   m_slot_list[slot_count_max];
+  std::uint16_t   m_bucket_list[bucket_count_max];
+  std::uint64_t   m_seed;
+  int             m_entry_count;
+  unsigned int    m_slot_mask;
+  unsigned int    m_bucket_mask;
+  bool            m_ready_bit;
+
+  private:
+  static  std::uint64_t emi_get_hash(std::uint64_t, const char*, std::size_t) noexcept;
+  static  unsigned int  emi_get_slot(std::uint64_t, unsigned int, unsigned int) noexcept;
+          bool    emi_place(std::uint64_t) noexcept;
+
+  public:
+          dispatch() noexcept;
+          dispatch(const dispatch&) noexcept = delete;
+          dispatch(dispatch&&) noexcept = delete;
+          ~dispatch();
+
+          bool    insert(const char*, stage*, int) noexcept;
+          bool    build() noexcept;
+  const   entry_t* find(const char*, std::size_t) const noexcept;
+  const   entry_t* find(const char*) const noexcept;
+          int     get_count() const noexcept;
+          void    clear() noexcept;
+
+          dispatch& operator=(const dispatch&) noexcept = delete;
+          dispatch& operator=(dispatch&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
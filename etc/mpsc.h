@@ -0,0 +1,108 @@
+#ifndef emc_mpsc_h
+#define emc_mpsc_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+#include <atomic>
+
+namespace emc {
+
+/* mpsc
+   bounded, lock-free, multiple producer - single consumer queue;
+   push() may be called from any thread, pop() only from the consumer thread.
+*/
+template<typename Xt, unsigned int Size>
+class mpsc
+{
+  static_assert((Size > 1) && ((Size & (Size - 1)) == 0), "queue size must be a power of two");
+
+  static constexpr std::size_t  s_mask = Size - 1;
+
+  struct cell_t {
+    std::atomic<std::size_t>    m_sequence;
+    Xt                          m_value;
+  };
+
+  cell_t                        m_cell_list[Size];
+  alignas(64) std::atomic<std::size_t> m_tail;
+  alignas(64) std::size_t       m_head;
+
+  public:
+  inline  mpsc() noexcept:
+          m_tail(0),
+          m_head(0) {
+          for(std::size_t i_cell = 0; i_cell < Size; i_cell++) {
+              m_cell_list[i_cell].m_sequence.store(i_cell, std::memory_order_relaxed);
+          }
+  }
+
+          mpsc(const mpsc&) noexcept = delete;
+          mpsc(mpsc&&) noexcept = delete;
+          ~mpsc() = default;
+
+  /* push()
+     returns false if the queue is full
+  */
+  inline  bool  push(const Xt& value) noexcept {
+          cell_t*     l_cell;
+          std::size_t l_sequence;
+          std::size_t l_tail = m_tail.load(std::memory_order_relaxed);
+          while(true) {
+              l_cell     = std::addressof(m_cell_list[l_tail & s_mask]);
+              l_sequence = l_cell->m_sequence.load(std::memory_order_acquire);
+              auto l_diff = static_cast<std::intptr_t>(l_sequence) - static_cast<std::intptr_t>(l_tail);
+              if(l_diff == 0) {
+                  if(m_tail.compare_exchange_weak(l_tail, l_tail + 1, std::memory_order_relaxed)) {
+                      break;
+                  }
+              } else
+              if(l_diff < 0) {
+                  return false;
+              } else
+                  l_tail = m_tail.load(std::memory_order_relaxed);
+          }
+          l_cell->m_value = value;
+          l_cell->m_sequence.store(l_tail + 1, std::memory_order_release);
+          return true;
+  }
+
+  /* pop()
+     returns false if the queue is empty
+  */
+  inline  bool  pop(Xt& value) noexcept {
+          cell_t*     l_cell = std::addressof(m_cell_list[m_head & s_mask]);
+          std::size_t l_sequence = l_cell->m_sequence.load(std::memory_order_acquire);
+          if(static_cast<std::intptr_t>(l_sequence) - static_cast<std::intptr_t>(m_head + 1) < 0) {
+              return false;
+          }
+          value = l_cell->m_value;
+          l_cell->m_sequence.store(m_head + Size, std::memory_order_release);
+          m_head++;
+          return true;
+  }
+
+          mpsc& operator=(const mpsc&) noexcept = delete;
+          mpsc& operator=(mpsc&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,131 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "pool.h"
+#include <cstdlib>
+
+namespace emc {
+
+      pool::pool(std::size_t size_max, int depth) noexcept:
+      p_free_list{},
+      m_free_count{},
+      m_class_count(0),
+      m_depth(depth)
+{
+      std::size_t l_block_size = block_size_min;
+      while(m_class_count < class_count_max) {
+          m_class_count++;
+          if(l_block_size >= size_max) {
+              break;
+          }
+          l_block_size <<= 1;
+      }
+}
+
+      pool::~pool()
+{
+      dispose();
+}
+
+/* emi_get_class()
+   find the smallest size class able to hold `size` bytes, or -1 if the size is over the largest class
+*/
+int   pool::emi_get_class(std::size_t size) const noexcept
+{
+      int         l_class = 0;
+      std::size_t l_block_size = block_size_min;
+      while(l_class < m_class_count) {
+          if(size <= l_block_size) {
+              return l_class;
+          }
+          l_block_size <<= 1;
+          l_class++;
+      }
+      return -1;
+}
+
+/* get()
+   obtain a block of at least `size` bytes; returns nullptr if the size is over the largest class or the system
+   allocator failed
+*/
+std::uint8_t* pool::get(std::size_t size) noexcept
+{
+      int l_class = emi_get_class(size);
+      if(l_class >= 0) {
+          node_t* l_node = p_free_list[l_class];
+          if(l_node != nullptr) {
+              p_free_list[l_class] = l_node->p_next;
+              m_free_count[l_class]--;
+              return reinterpret_cast<std::uint8_t*>(l_node);
+          }
+          return reinterpret_cast<std::uint8_t*>(std::malloc(block_size_min << l_class));
+      }
+      return nullptr;
+}
+
+/* put()
+   return a block obtained via get(); `size` must be the same as the one the block was requested with
+*/
+void  pool::put(std::uint8_t* data, std::size_t size) noexcept
+{
+      int l_class = emi_get_class(size);
+      if(data != nullptr) {
+          if((l_class >= 0) &&
+              (m_free_count[l_class] < m_depth)) {
+              node_t* l_node = reinterpret_cast<node_t*>(data);
+              l_node->p_next = p_free_list[l_class];
+              p_free_list[l_class] = l_node;
+              m_free_count[l_class]++;
+          } else
+              std::free(data);
+      }
+}
+
+/* get_block_size()
+   actual size of the block that would be handed out for a request of `size` bytes, or 0 if the request can't be served
+*/
+std::size_t pool::get_block_size(std::size_t size) const noexcept
+{
+      int l_class = emi_get_class(size);
+      if(l_class >= 0) {
+          return block_size_min << l_class;
+      }
+      return 0u;
+}
+
+std::size_t pool::get_block_size_max() const noexcept
+{
+      return block_size_min << (m_class_count - 1);
+}
+
+void  pool::dispose() noexcept
+{
+      for(int i_class = 0; i_class < m_class_count; i_class++) {
+          while(p_free_list[i_class] != nullptr) {
+              node_t* l_node = p_free_list[i_class];
+              p_free_list[i_class] = l_node->p_next;
+              std::free(l_node);
+          }
+          m_free_count[i_class] = 0;
+      }
+}
+
+/*namespace emc*/ }
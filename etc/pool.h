@@ -0,0 +1,69 @@
+#ifndef emc_pool_h
+#define emc_pool_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+
+namespace emc {
+
+/* pool
+   size-classed free list allocator for blocks that need to outlive a dispatch; block sizes are powers of two, from
+   block_size_min up to the size given to the constructor; released blocks are kept for reuse, up to a fixed number of
+   blocks per class, so memory use stays bounded and the steady state does not hit the system allocator
+*/
+class pool
+{
+  struct node_t {
+    node_t*       p_next;
+  };
+
+  public:
+  static constexpr int          class_count_max = 16;
+  static constexpr std::size_t  block_size_min = 64u;
+
+  private:
+  node_t*         p_free_list[class_count_max];
+  int             m_free_count[class_count_max];
+  int             m_class_count;
+  int             m_depth;
+
+  private:
+          int     emi_get_class(std::size_t) const noexcept;
+
+  public:
+          pool(std::size_t, int) noexcept;
+          pool(const pool&) noexcept = delete;
+          pool(pool&&) noexcept = delete;
+          ~pool();
+
+          std::uint8_t* get(std::size_t) noexcept;
+          void          put(std::uint8_t*, std::size_t) noexcept;
+          std::size_t   get_block_size(std::size_t) const noexcept;
+          std::size_t   get_block_size_max() const noexcept;
+          void          dispose() noexcept;
+
+          pool&   operator=(const pool&) noexcept = delete;
+          pool&   operator=(pool&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,300 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "wheel.h"
+
+namespace emc {
+
+/* wheel::entry
+*/
+      wheel::entry::entry() noexcept:
+      p_prev(nullptr),
+      p_next(nullptr),
+      p_owner(nullptr),
+      m_deadline(0u),
+      m_slot(0)
+{
+}
+
+      wheel::entry::~entry()
+{
+      cancel();
+}
+
+/* expire()
+   called once the deadline has passed, after the entry has been removed from the wheel
+*/
+void  wheel::entry::expire(std::uint64_t) noexcept
+{
+}
+
+bool  wheel::entry::is_pending() const noexcept
+{
+      return p_owner != nullptr;
+}
+
+std::uint64_t wheel::entry::get_deadline() const noexcept
+{
+      return m_deadline;
+}
+
+void  wheel::entry::cancel() noexcept
+{
+      if(p_owner != nullptr) {
+          p_owner->emi_remove(this);
+      }
+}
+
+/* wheel
+*/
+      wheel::wheel(std::uint64_t time) noexcept:
+      p_slot_list{},
+      p_fire_list(nullptr),
+      m_slot_bits{},
+      m_time(time),
+      m_count(0)
+{
+}
+
+      wheel::~wheel()
+{
+      clear();
+}
+
+/* emi_insert()
+   file an entry into the slot matching its deadline, on the finest level able to represent the distance from the next
+   tick to be processed (m_time + 1); deadlines past the wheel span are clamped onto the last level and re-filed later
+*/
+void  wheel::emi_insert(entry* entry_ptr) noexcept
+{
+      std::uint64_t l_next  = m_time + 1u;
+      std::uint64_t l_when  = entry_ptr->m_deadline;
+      int           l_level = 0;
+      int           l_index;
+      if(l_when < l_next) {
+          l_when = l_next;
+      }
+      while(l_level < level_count - 1) {
+          if(l_when - l_next < (std::uint64_t(1) << (slot_bits * (l_level + 1)))) {
+              break;
+          }
+          l_level++;
+      }
+      if(l_when - l_next >= span) {
+          l_when = l_next + span - 1u;
+      }
+      l_index = (l_when >> (slot_bits * l_level)) & (slot_count - 1);
+      entry_ptr->p_prev = nullptr;
+      entry_ptr->p_next = p_slot_list[l_level][l_index];
+      if(entry_ptr->p_next != nullptr) {
+          entry_ptr->p_next->p_prev = entry_ptr;
+      }
+      entry_ptr->m_slot = l_level * slot_count + l_index;
+      p_slot_list[l_level][l_index] = entry_ptr;
+      m_slot_bits[l_level] |= std::uint64_t(1) << l_index;
+}
+
+/* emi_remove()
+   unlink an entry from either its slot or the list of entries about to fire
+*/
+void  wheel::emi_remove(entry* entry_ptr) noexcept
+{
+      if(entry_ptr->p_prev != nullptr) {
+          entry_ptr->p_prev->p_next = entry_ptr->p_next;
+      } else
+      if(entry_ptr->m_slot < 0) {
+          p_fire_list = entry_ptr->p_next;
+      } else
+      {
+          int l_level = entry_ptr->m_slot / slot_count;
+          int l_index = entry_ptr->m_slot % slot_count;
+          p_slot_list[l_level][l_index] = entry_ptr->p_next;
+          if(entry_ptr->p_next == nullptr) {
+              m_slot_bits[l_level] &= ~(std::uint64_t(1) << l_index);
+          }
+      }
+      if(entry_ptr->p_next != nullptr) {
+          entry_ptr->p_next->p_prev = entry_ptr->p_prev;
+      }
+      entry_ptr->p_prev = nullptr;
+      entry_ptr->p_next = nullptr;
+      entry_ptr->p_owner = nullptr;
+      m_count--;
+}
+
+/* emi_cascade()
+   re-file the entries of a slot on the given level onto finer levels, now that the wheel has reached the slot
+*/
+void  wheel::emi_cascade(int level, int index) noexcept
+{
+      entry* i_entry = p_slot_list[level][index];
+      p_slot_list[level][index] = nullptr;
+      m_slot_bits[level] &= ~(std::uint64_t(1) << index);
+      while(i_entry != nullptr) {
+          entry* l_next = i_entry->p_next;
+          emi_insert(i_entry);
+          i_entry = l_next;
+      }
+}
+
+/* emi_fire()
+   process the next tick: pull down the coarser slots if the tick is on their boundary, then expire the entries in the
+   level 0 slot
+*/
+int   wheel::emi_fire(std::uint64_t time) noexcept
+{
+      int  l_count = 0;
+      int  l_index = time & (slot_count - 1);
+      // the ticks up to here were empty and may have been skipped: catch up before re-filing anything
+      m_time = time - 1u;
+      if(l_index == 0) {
+          for(int i_level = 1; i_level < level_count; i_level++) {
+              int l_level_index = (time >> (slot_bits * i_level)) & (slot_count - 1);
+              if(m_slot_bits[i_level] & (std::uint64_t(1) << l_level_index)) {
+                  emi_cascade(i_level, l_level_index);
+              }
+              if(l_level_index != 0) {
+                  break;
+              }
+          }
+      }
+      // move the slot onto the fire list: entries scheduled from within expire() land on the next tick instead
+      p_fire_list = p_slot_list[0][l_index];
+      p_slot_list[0][l_index] = nullptr;
+      m_slot_bits[0] &= ~(std::uint64_t(1) << l_index);
+      for(entry* i_entry = p_fire_list; i_entry != nullptr; i_entry = i_entry->p_next) {
+          i_entry->m_slot = -1;
+      }
+      m_time = time;
+      while(p_fire_list != nullptr) {
+          entry* l_entry = p_fire_list;
+          emi_remove(l_entry);
+          l_entry->expire(time);
+          l_count++;
+      }
+      return l_count;
+}
+
+/* schedule()
+   (re)arm an entry to expire at the given absolute time; deadlines that already passed expire on the next tick
+*/
+void  wheel::schedule(entry* entry_ptr, std::uint64_t deadline) noexcept
+{
+      if(entry_ptr->p_owner != nullptr) {
+          entry_ptr->p_owner->emi_remove(entry_ptr);
+      }
+      entry_ptr->p_owner = this;
+      entry_ptr->m_deadline = deadline;
+      emi_insert(entry_ptr);
+      m_count++;
+}
+
+void  wheel::cancel(entry* entry_ptr) noexcept
+{
+      if(entry_ptr->p_owner == this) {
+          emi_remove(entry_ptr);
+      }
+}
+
+/* advance()
+   move the wheel forward up to and including the given time, expiring any entries due; only the slots that are
+   occupied, or that sit on a coarser level boundary, are visited; returns the number of expired entries
+*/
+int   wheel::advance(std::uint64_t time) noexcept
+{
+      int  l_count = 0;
+      while(m_time < time) {
+          std::uint64_t l_next = m_time + 1u;
+          if(m_count == 0) {
+              m_time = time;
+              break;
+          }
+          if(l_next & (slot_count - 1)) {
+              // not on a level boundary: skip to the next occupied level 0 slot, or to the boundary
+              std::uint64_t l_bits = m_slot_bits[0] >> (l_next & (slot_count - 1));
+              if(l_bits != 0u) {
+                  l_next += __builtin_ctzll(l_bits);
+              } else
+                  l_next = (l_next | (slot_count - 1)) + 1u;
+              if(l_next > time) {
+                  m_time = time;
+                  break;
+              }
+          }
+          l_count += emi_fire(l_next);
+      }
+      return l_count;
+}
+
+/* get_time()
+   time of the last processed tick
+*/
+std::uint64_t wheel::get_time() const noexcept
+{
+      return m_time;
+}
+
+/* get_wait_time()
+   number of ticks the wheel can stay idle before advance() may have entries to expire, capped at `limit`; useful for
+   computing poll timeouts
+*/
+std::uint64_t wheel::get_wait_time(std::uint64_t limit) const noexcept
+{
+      std::uint64_t l_wait = limit;
+      if(m_count > 0) {
+          std::uint64_t l_next = m_time + 1u;
+          std::uint64_t l_bits = m_slot_bits[0] >> (l_next & (slot_count - 1));
+          if((l_next & (slot_count - 1)) == 0u) {
+              l_wait = 1u;
+          } else
+          if(l_bits != 0u) {
+              l_wait = 1u + __builtin_ctzll(l_bits);
+          } else
+              l_wait = ((l_next | (slot_count - 1)) + 1u) - m_time;
+          if(l_wait > limit) {
+              l_wait = limit;
+          }
+      }
+      return l_wait;
+}
+
+int   wheel::get_count() const noexcept
+{
+      return m_count;
+}
+
+/* clear()
+   drop all entries without expiring them
+*/
+void  wheel::clear() noexcept
+{
+      for(int i_level = 0; i_level < level_count; i_level++) {
+          while(m_slot_bits[i_level] != 0u) {
+              int l_index = __builtin_ctzll(m_slot_bits[i_level]);
+              emi_remove(p_slot_list[i_level][l_index]);
+          }
+      }
+      while(p_fire_list != nullptr) {
+          emi_remove(p_fire_list);
+      }
+}
+
+/*namespace emc*/ }
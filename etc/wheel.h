@@ -0,0 +1,104 @@
+#ifndef emc_wheel_h
+#define emc_wheel_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+
+namespace emc {
+
+/* wheel
+   hierarchical timing wheel: level_count levels of slot_count slots each, level 0 slots being one tick wide and each
+   subsequent level slot_count times coarser; entries are kept in intrusive lists and only the ones that expire (or need
+   to be moved down one level) are visited as the clock advances; occupancy bitmaps allow skipping over empty slots;
+   deadlines further away than the wheel span are parked in the last level and re-filed as the wheel turns.
+*/
+class wheel
+{
+  public:
+  static constexpr int           slot_bits = 6;
+  static constexpr int           slot_count = 1 << slot_bits;
+  static constexpr int           level_count = 4;
+  static constexpr std::uint64_t span = std::uint64_t(1) << (slot_bits * level_count);
+
+  /* entry
+     intrusive wheel entry; derived objects override expire(), which is called on the wheel owner's thread once the
+     deadline has passed; an entry may be scheduled again from within expire()
+  */
+  class entry
+  {
+    entry*          p_prev;
+    entry*          p_next;
+    wheel*          p_owner;
+    std::uint64_t   m_deadline;
+    int             m_slot;
+
+    protected:
+    virtual void    expire(std::uint64_t) noexcept;
+
+    friend class wheel;
+    public:
+            entry() noexcept;
+            entry(const entry&) noexcept = delete;
+            entry(entry&&) noexcept = delete;
+    virtual ~entry();
+
+            bool          is_pending() const noexcept;
+            std::uint64_t get_deadline() const noexcept;
+            void          cancel() noexcept;
+
+            entry&        operator=(const entry&) noexcept = delete;
+            entry&        operator=(entry&&) noexcept = delete;
+  };
+
+  private:
+  entry*          p_slot_list[level_count][slot_count];
+  entry*          p_fire_list;
+  std::uint64_t   m_slot_bits[level_count];
+  std::uint64_t   m_time;
+  int             m_count;
+
+  private:
+          void    emi_insert(entry*) noexcept;
+          void    emi_remove(entry*) noexcept;
+          void    emi_cascade(int, int) noexcept;
+          int     emi_fire(std::uint64_t) noexcept;
+
+  public:
+          wheel(std::uint64_t = 0u) noexcept;
+          wheel(const wheel&) noexcept = delete;
+          wheel(wheel&&) noexcept = delete;
+          ~wheel();
+
+          void          schedule(entry*, std::uint64_t) noexcept;
+          void          cancel(entry*) noexcept;
+          int           advance(std::uint64_t) noexcept;
+          std::uint64_t get_time() const noexcept;
+          std::uint64_t get_wait_time(std::uint64_t) const noexcept;
+          int           get_count() const noexcept;
+          void          clear() noexcept;
+
+          wheel&        operator=(const wheel&) noexcept = delete;
+          wheel&        operator=(wheel&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -20,6 +20,7 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "event.h"
+#include "buffer.h"
 #include <string>
 
 namespace emc {
@@ -91,6 +92,42 @@ event_info_t event_info_t::for_send(int bus, std::uint8_t* data, std::size_t siz
       return l_result;
 }
 
+event_info_t event_info_t::for_recv(int bus, emc::buffer* buffer) noexcept
+{
+      event_info_t l_result;
+      l_result.recv.bus = bus;
+      l_result.recv.data = buffer->get_data();
+      l_result.recv.size = buffer->get_size();
+      l_result.recv.buffer = buffer;
+      return l_result;
+}
+
+event_info_t event_info_t::for_send(int bus, emc::buffer* buffer) noexcept
+{
+      event_info_t l_result;
+      l_result.send.bus = bus;
+      l_result.send.data = buffer->get_data();
+      l_result.send.size = buffer->get_size();
+      l_result.send.buffer = buffer;
+      return l_result;
+}
+
+event_info_t event_info_t::for_recv_batch(message_t* list, int count) noexcept
+{
+      event_info_t l_result;
+      l_result.recv_batch.list = list;
+      l_result.recv_batch.count = count;
+      return l_result;
+}
+
+event_info_t event_info_t::for_send_batch(message_t* list, int count) noexcept
+{
+      event_info_t l_result;
+      l_result.send_batch.list = list;
+      l_result.send_batch.count = count;
+      return l_result;
+}
+
 event_info_t& event_info_t::operator=(const event_info_t& rhs) noexcept
 {
       if(std::addressof(rhs) != this) {
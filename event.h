@@ -37,6 +37,8 @@ enum class event
   join = 30,
   recv = 31,              // called last on the reactor after a received message has passed through every stage in the pipeline
   send = 32,              // called last on the reactor after a message to be sent has passed through every stage in the pipeline
+  recv_batch = 33,        // same as recv, for a batch of messages; relayed as individual recv events if not handled
+  send_batch = 34,        // same as send, for a batch of messages; relayed as individual send events if not handled
   progress = 36,
   terminating = 126,
   drop = 127,
@@ -49,6 +51,16 @@ enum class event
   user_last = 65535
 };
 
+/* message_t
+   descriptor of a message travelling through the pipeline as part of a batch
+*/
+struct message_t
+{
+  int           bus;
+  std::uint8_t* data;
+  std::size_t   size;
+};
+
 union event_info_t
 {
   int descriptor;
@@ -66,8 +78,14 @@ union event_info_t
     int           bus;
     std::uint8_t* data;
     std::size_t   size;
+    emc::buffer*  buffer;   // owning buffer of `data`, if the message travelled the pipeline as a buffer; may be nullptr
   } recv, send;
 
+  struct {
+    message_t*    list;
+    int           count;
+  } recv_batch, send_batch;
+
   char bytes[0];
 
   public:
@@ -77,6 +95,10 @@ union event_info_t
   static  event_info_t for_hup(int) noexcept;
   static  event_info_t for_recv(int, std::uint8_t*, std::size_t) noexcept;
   static  event_info_t for_send(int, std::uint8_t*, std::size_t) noexcept;
+  static  event_info_t for_recv(int, emc::buffer*) noexcept;
+  static  event_info_t for_send(int, emc::buffer*) noexcept;
+  static  event_info_t for_recv_batch(message_t*, int) noexcept;
+  static  event_info_t for_send_batch(message_t*, int) noexcept;
 
   public:
           event_info_t() noexcept;
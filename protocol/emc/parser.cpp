@@ -0,0 +1,270 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "parser.h"
+#include <cstring>
+
+namespace emc {
+
+static inline bool  emc_is_eol(std::uint8_t value) noexcept
+{
+      return (value == '\r') || (value == '\n');
+}
+
+static inline bool  emc_is_space(char value) noexcept
+{
+      return (value == ' ') || (value == '\t');
+}
+
+static inline bool  emc_is_packet(std::uint8_t value) noexcept
+{
+      return (value >= 0x80) && (value <= 0xfe);
+}
+
+/* emc_find_eol()
+   find the first end of line character in [ptr, end); returns `end` if there is none
+*/
+static inline const std::uint8_t* emc_find_eol(const std::uint8_t* ptr, const std::uint8_t* end) noexcept
+{
+      return ptr + emc_scan_eol(ptr, end - ptr);
+}
+
+      emcparser::emcparser() noexcept:
+      p_input_ptr(nullptr),
+      p_input_end(nullptr),
+      m_state(state::idle),
+      m_channel(chid_none),
+      m_head_size(0),
+      m_data_size(0),
+      m_carry_size(0)
+{
+}
+
+      emcparser::~emcparser()
+{
+}
+
+/* emi_carry()
+   append the part of an item found at the end of a read onto the carry buffer; returns false if it doesn't fit
+*/
+bool  emcparser::emi_carry(const std::uint8_t* data, std::size_t size) noexcept
+{
+      if(size > line_size_max - m_carry_size) {
+          return false;
+      }
+      if(size > 0) {
+          std::memcpy(m_carry_data + m_carry_size, data, size);
+          m_carry_size += size;
+      }
+      return true;
+}
+
+/* emi_make_line()
+   classify a line by its tag and split it into arguments, all in place
+*/
+void  emcparser::emi_make_line(item_t& item, const std::uint8_t* data, std::size_t size) noexcept
+{
+      auto  p_line = reinterpret_cast<const char*>(data);
+      auto  p_end  = p_line + size;
+      item.kind = type::line;
+      item.channel = chid_none;
+      if(size > 0) {
+          if(p_line[0] == emc_tag_request) {
+              item.kind = type::request;
+              p_line++;
+          } else
+          if(p_line[0] == emc_tag_response) {
+              item.kind = type::response;
+              p_line++;
+          }
+      }
+      item.data = std::string_view(p_line, p_end - p_line);
+      item.argc = 0;
+      while(p_line < p_end) {
+          const char* p_arg;
+          while(emc_is_space(*p_line)) {
+              if(++p_line == p_end) {
+                  return;
+              }
+          }
+          p_arg = p_line;
+          if(item.argc == argc_max - 1) {
+              // out of slots: the last argument takes the rest of the line
+              while(emc_is_space(p_end[-1])) {
+                  p_end--;
+              }
+              item.argv[item.argc++] = std::string_view(p_arg, p_end - p_arg);
+              return;
+          }
+          while((p_line < p_end) && (emc_is_space(*p_line) == false)) {
+              p_line++;
+          }
+          item.argv[item.argc++] = std::string_view(p_arg, p_line - p_arg);
+      }
+}
+
+void  emcparser::emi_make_packet(item_t& item, const std::uint8_t* data, std::size_t size) noexcept
+{
+      item.kind = type::packet;
+      item.channel = m_channel;
+      item.data = std::string_view(reinterpret_cast<const char*>(data), size);
+      item.argc = 0;
+}
+
+void  emcparser::emi_make_error(item_t& item) noexcept
+{
+      item.kind = type::error;
+      item.channel = chid_none;
+      item.data = std::string_view();
+      item.argc = 0;
+}
+
+/* feed()
+   supply the next read; anything left over from the previous one that next() has not been called for is discarded
+*/
+void  emcparser::feed(const std::uint8_t* data, std::size_t size) noexcept
+{
+      p_input_ptr = data;
+      p_input_end = data + size;
+}
+
+void  emcparser::feed(const char* data, std::size_t size) noexcept
+{
+      feed(reinterpret_cast<const std::uint8_t*>(data), size);
+}
+
+/* next()
+   parse up to the end of the next item; returns false once the current read is exhausted, with any incomplete item
+   carried over onto the next one
+*/
+bool  emcparser::next(item_t& item) noexcept
+{
+      while(p_input_ptr < p_input_end) {
+          if(m_state == state::idle) {
+              std::uint8_t l_value = *p_input_ptr;
+              if(emc_is_eol(l_value)) {
+                  // end of the previous item or an empty line
+                  p_input_ptr++;
+              } else
+              if(emc_is_packet(l_value)) {
+                  m_channel = 0xff - l_value;
+                  m_head_size = 0;
+                  m_data_size = 0;
+                  m_state = state::head;
+                  p_input_ptr++;
+              }
+              else {
+                  m_carry_size = 0;
+                  m_state = state::line;
+              }
+          } else
+          if(m_state == state::line) {
+              auto p_eol = emc_find_eol(p_input_ptr, p_input_end);
+              auto l_size = static_cast<std::size_t>(p_eol - p_input_ptr);
+              if(p_eol < p_input_end) {
+                  m_state = state::idle;
+                  if(m_carry_size == 0) {
+                      if(l_size <= line_size_max) {
+                          emi_make_line(item, p_input_ptr, l_size);
+                      } else
+                          emi_make_error(item);
+                  } else
+                  if(emi_carry(p_input_ptr, l_size)) {
+                      emi_make_line(item, m_carry_data, m_carry_size);
+                  } else
+                      emi_make_error(item);
+                  p_input_ptr = p_eol;
+                  return true;
+              }
+              if(emi_carry(p_input_ptr, l_size) == false) {
+                  m_state = state::skip;
+                  emi_make_error(item);
+                  return true;
+              }
+              p_input_ptr = p_input_end;
+          } else
+          if(m_state == state::head) {
+              int l_digit = emc_get_hex(*p_input_ptr);
+              if(l_digit < 0) {
+                  m_state = state::skip;
+                  emi_make_error(item);
+                  return true;
+              }
+              m_data_size = (m_data_size << 4) | l_digit;
+              p_input_ptr++;
+              if(++m_head_size == emc_packet_header_size - 1) {
+                  m_carry_size = 0;
+                  m_state = state::data;
+                  if(m_data_size == 0) {
+                      m_state = state::idle;
+                      emi_make_packet(item, m_carry_data, 0);
+                      return true;
+                  }
+              }
+          } else
+          if(m_state == state::data) {
+              auto l_size = static_cast<std::size_t>(p_input_end - p_input_ptr);
+              auto l_need = m_data_size - m_carry_size;
+              if(l_size >= l_need) {
+                  m_state = state::idle;
+                  if(m_carry_size == 0) {
+                      emi_make_packet(item, p_input_ptr, l_need);
+                  }
+                  else {
+                      emi_carry(p_input_ptr, l_need);
+                      emi_make_packet(item, m_carry_data, m_carry_size);
+                  }
+                  p_input_ptr += l_need;
+                  return true;
+              }
+              emi_carry(p_input_ptr, l_size);
+              p_input_ptr = p_input_end;
+          } else
+          if(m_state == state::skip) {
+              p_input_ptr = emc_find_eol(p_input_ptr, p_input_end);
+              if(p_input_ptr < p_input_end) {
+                  m_state = state::idle;
+              }
+          }
+      }
+      return false;
+}
+
+/* has_pending()
+   test whether an incomplete item has been carried over from the previous reads
+*/
+bool  emcparser::has_pending() const noexcept
+{
+      return m_state != state::idle;
+}
+
+void  emcparser::reset() noexcept
+{
+      p_input_ptr = nullptr;
+      p_input_end = nullptr;
+      m_state = state::idle;
+      m_channel = chid_none;
+      m_head_size = 0;
+      m_data_size = 0;
+      m_carry_size = 0;
+}
+
+/*namespace emc*/ }
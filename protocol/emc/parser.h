@@ -0,0 +1,135 @@
+#ifndef emc_protocol_parser_h
+#define emc_protocol_parser_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include "protocol.h"
+#include <string_view>
+
+namespace emc {
+
+/* boundary
+   kind of framing boundary found by emc_scan_boundary()
+*/
+enum class boundary {
+  none,
+  eol,
+  packet
+};
+
+std::size_t  emc_scan_eol(const std::uint8_t*, std::size_t) noexcept;
+std::size_t  emc_scan_boundary(const std::uint8_t*, std::size_t, boundary&) noexcept;
+const char*  emc_get_scan_kernel_name() noexcept;
+
+/* emcparser
+   Incremental parser for the EMC protocol stream (README, section 3): splits the input into requests ('?' RQID ...),
+   responses (']' RSID ...), other lines and channel packets ([\x80-\xfe] SIZE DATA), whichever way the input has been
+   cut into reads;
+   - feed() hands the parser the next read, next() pulls the items completed within it, one at a time, until it
+     returns false, at which point the read has been consumed entirely and the next one can be fed;
+   - the items, including the argument vector of the lines, are views: into the fed input whenever an item is fully
+     contained within a single read, or into the carry buffer of the parser for the items that straddle reads; either
+     way they only remain valid until the next call to next() or feed();
+   - nothing is allocated: input that is not part of a complete item is copied into the carry buffer, which limits
+     the size of a line to line_size_max; longer lines, as well as malformed packet headers, are reported as errors
+     and skipped up to the next end of line.
+*/
+class emcparser
+{
+  public:
+  enum class type {
+    none,
+    line,
+    request,
+    response,
+    packet,
+    error
+  };
+
+  /* argc_max
+     maximum number of arguments split out of a line; the last one extends to the end of the line
+  */
+  static constexpr int argc_max = 16;
+
+  /* line_size_max
+     maximum size of a line or of a packet that can be carried over between reads; packets are limited by the 3 hex
+     digits of their size field
+  */
+  static constexpr std::size_t line_size_max = 4096;
+  static constexpr std::size_t packet_size_limit = 0xfff;
+
+  static_assert(packet_size_limit <= line_size_max, "carry buffer can't hold the largest packet");
+
+  /* item_t
+     - for lines: `data` is the line without its tag and end of line, split into `argv` on white space;
+     - for packets: `channel` is the channel id, `data` the payload.
+  */
+  struct item_t {
+    type              kind;
+    int               channel;
+    std::string_view  data;
+    int               argc;
+    std::string_view  argv[argc_max];
+  };
+
+  private:
+  enum class state {
+    idle,
+    line,
+    head,
+    data,
+    skip
+  };
+
+  const std::uint8_t* p_input_ptr;
+  const std::uint8_t* p_input_end;
+  state         m_state;
+  int           m_channel;
+  int           m_head_size;
+  std::size_t   m_data_size;
+  std::size_t   m_carry_size;
+  std::uint8_t  m_carry_data[line_size_max];
+
+  private:
+          bool  emi_carry(const std::uint8_t*, std::size_t) noexcept;
+          void  emi_make_line(item_t&, const std::uint8_t*, std::size_t) noexcept;
+          void  emi_make_packet(item_t&, const std::uint8_t*, std::size_t) noexcept;
+          void  emi_make_error(item_t&) noexcept;
+
+  public:
+          emcparser() noexcept;
+          emcparser(const emcparser&) noexcept = delete;
+          emcparser(emcparser&&) noexcept = delete;
+          ~emcparser();
+
+          void  feed(const std::uint8_t*, std::size_t) noexcept;
+          void  feed(const char*, std::size_t) noexcept;
+          bool  next(item_t&) noexcept;
+          bool  has_pending() const noexcept;
+          void  reset() noexcept;
+
+          emcparser& operator=(const emcparser&) noexcept = delete;
+          emcparser& operator=(emcparser&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -30,6 +30,7 @@ constexpr char emc_tag_request = '?';
 constexpr char emc_tag_help = '?';
 constexpr char emc_tag_response = ']';
 constexpr char emc_tag_sync = '@';
+constexpr char emc_tag_mark = '#';   // request tag, or window size in the info exchange
 
 constexpr char emc_request_info = 'i';
 constexpr char emc_request_service = 's';
@@ -66,5 +67,22 @@ constexpr char emc_proto_ident_chs[] = "0123456789abcdefghijklmnopqrstuvwxyz-";
 constexpr char emc_machine_ident_chs[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ-_";
 constexpr char emc_decimal_chs[] = "0123456789";
 
+/* emc_get_hex()
+   value of a single hex digit, either case, or -1 if `value` is not one
+*/
+inline int  emc_get_hex(std::uint8_t value) noexcept
+{
+      if((value >= '0') && (value <= '9')) {
+          return value - '0';
+      } else
+      if((value >= 'A') && (value <= 'F')) {
+          return value - 'A' + 10;
+      } else
+      if((value >= 'a') && (value <= 'f')) {
+          return value - 'a' + 10;
+      }
+      return -1;
+}
+
 /*namespace emc*/ }
 #endif
@@ -0,0 +1,227 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "parser.h"
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace emc {
+
+/* scan_class_*
+   what each byte value is to the framing: an end of line, the tag of a channel packet or neither
+*/
+static constexpr std::uint8_t scan_class_none = 0u;
+static constexpr std::uint8_t scan_class_eol = 1u;
+static constexpr std::uint8_t scan_class_packet = 2u;
+
+struct scan_class_map_t
+{
+  std::uint8_t  value[256];
+
+  constexpr scan_class_map_t() noexcept:
+  value() {
+      for(int i_byte = 0; i_byte < 256; i_byte++) {
+          if((i_byte == '\r') || (i_byte == '\n')) {
+              value[i_byte] = scan_class_eol;
+          } else
+          if((i_byte >= 0x80) && (i_byte <= 0xfe)) {
+              value[i_byte] = scan_class_packet;
+          } else
+              value[i_byte] = scan_class_none;
+      }
+  }
+};
+
+static constexpr scan_class_map_t s_scan_class_map;
+
+/* emc_scan_scalar()
+   returns the offset of the first byte of any of the classes in `mask`, or `size` if there is none
+*/
+static std::size_t emc_scan_scalar(const std::uint8_t* src, std::size_t size, std::uint8_t mask) noexcept
+{
+      std::size_t l_done = 0;
+      while(l_done < size) {
+          if(s_scan_class_map.value[src[l_done]] & mask) {
+              break;
+          }
+          l_done++;
+      }
+      return l_done;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+static inline unsigned int emc_scan_sse2_mask(__m128i data, __m128i packet) noexcept
+{
+      __m128i l_hit = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(data, _mm_set1_epi8('\n'))),
+          _mm_and_si128(_mm_cmplt_epi8(data, _mm_set1_epi8(-1)), packet)
+      );
+      return _mm_movemask_epi8(l_hit);
+}
+
+/* emc_scan_sse2()
+   classify 32 bytes per step, as two 16 byte vectors; the packet tags 0x80..0xfe are the bytes below -1 when taken
+   as signed; a tail shorter than a vector is covered by one last vector ending on the last byte, overlapping the
+   bytes already scanned, so only inputs shorter than 16 bytes are left over for the scalar implementation;
+   returns the offset of the first match or, if there is none, the number of bytes scanned
+*/
+__attribute__((target("sse2")))
+static std::size_t emc_scan_sse2(const std::uint8_t* src, std::size_t size, std::uint8_t mask) noexcept
+{
+      std::size_t  l_done = 0;
+      unsigned int l_mask;
+      __m128i      l_packet = _mm_set1_epi8((mask & scan_class_packet) ? -1 : 0);
+      while(size - l_done >= 32) {
+          l_mask = emc_scan_sse2_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done)), l_packet) |
+              (emc_scan_sse2_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done + 16)), l_packet) << 16);
+          if(l_mask) {
+              return l_done + __builtin_ctz(l_mask);
+          }
+          l_done += 32;
+      }
+      if(size - l_done >= 16) {
+          l_mask = emc_scan_sse2_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done)), l_packet);
+          if(l_mask) {
+              return l_done + __builtin_ctz(l_mask);
+          }
+          l_done += 16;
+      }
+      if((l_done < size) &&
+          (size >= 16)) {
+          l_mask = emc_scan_sse2_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + size - 16)), l_packet);
+          l_mask >>= l_done - (size - 16);
+          if(l_mask) {
+              return l_done + __builtin_ctz(l_mask);
+          }
+          l_done = size;
+      }
+      return l_done;
+}
+
+/* emc_scan_avx2()
+   same as the SSE2 kernel, on 64 bytes per step; the tail goes through the SSE2 kernel
+*/
+__attribute__((target("avx2")))
+static std::size_t emc_scan_avx2(const std::uint8_t* src, std::size_t size, std::uint8_t mask) noexcept
+{
+      std::size_t l_done = 0;
+      __m256i     l_cr = _mm256_set1_epi8('\r');
+      __m256i     l_lf = _mm256_set1_epi8('\n');
+      __m256i     l_ff = _mm256_set1_epi8(-1);
+      __m256i     l_packet = _mm256_set1_epi8((mask & scan_class_packet) ? -1 : 0);
+      while(size - l_done >= 64) {
+          __m256i  l_data_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          __m256i  l_data_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done + 32));
+          __m256i  l_hit_0 = _mm256_or_si256(
+              _mm256_or_si256(_mm256_cmpeq_epi8(l_data_0, l_cr), _mm256_cmpeq_epi8(l_data_0, l_lf)),
+              _mm256_and_si256(_mm256_cmpgt_epi8(l_ff, l_data_0), l_packet)
+          );
+          __m256i  l_hit_1 = _mm256_or_si256(
+              _mm256_or_si256(_mm256_cmpeq_epi8(l_data_1, l_cr), _mm256_cmpeq_epi8(l_data_1, l_lf)),
+              _mm256_and_si256(_mm256_cmpgt_epi8(l_ff, l_data_1), l_packet)
+          );
+          std::uint64_t l_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(l_hit_0)) |
+              (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(l_hit_1))) << 32);
+          if(l_mask) {
+              return l_done + __builtin_ctzll(l_mask);
+          }
+          l_done += 64;
+      }
+      _mm256_zeroupper();
+      return l_done + emc_scan_sse2(src + l_done, size - l_done, mask);
+}
+#endif
+
+/* scan_kernel_t
+   vector kernel picked once, at load time, from the features reported by cpuid
+*/
+struct scan_kernel_t
+{
+  std::size_t (*scan)(const std::uint8_t*, std::size_t, std::uint8_t) noexcept;
+  const char*   name;
+};
+
+static std::size_t emc_scan_none(const std::uint8_t*, std::size_t, std::uint8_t) noexcept
+{
+      return 0;
+}
+
+/* emc_get_scan_kernel()
+   pick the widest kernel the cpu supports, unless EMC_NO_SIMD is set in the environment
+*/
+static scan_kernel_t emc_get_scan_kernel() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+      if(std::getenv("EMC_NO_SIMD") == nullptr) {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx2")) {
+              return {emc_scan_avx2, "avx2"};
+          }
+          if(__builtin_cpu_supports("sse2")) {
+              return {emc_scan_sse2, "sse2"};
+          }
+      }
+#endif
+      return {emc_scan_none, "scalar"};
+}
+
+static const scan_kernel_t s_scan_kernel = emc_get_scan_kernel();
+
+static inline std::size_t emc_scan(const std::uint8_t* src, std::size_t size, std::uint8_t mask) noexcept
+{
+      std::size_t l_done = s_scan_kernel.scan(src, size, mask);
+      return l_done + emc_scan_scalar(src + l_done, size - l_done, mask);
+}
+
+/* emc_scan_eol()
+   find the next end of line character ('\r' or '\n'); returns its offset or `size` if there is none
+*/
+std::size_t emc_scan_eol(const std::uint8_t* src, std::size_t size) noexcept
+{
+      return emc_scan(src, size, scan_class_eol);
+}
+
+/* emc_scan_boundary()
+   find the next end of line character or channel packet tag; returns its offset and sets `kind` accordingly, or
+   returns `size` and sets `kind` to boundary::none if there is neither
+*/
+std::size_t emc_scan_boundary(const std::uint8_t* src, std::size_t size, boundary& kind) noexcept
+{
+      std::size_t l_offset = emc_scan(src, size, scan_class_eol | scan_class_packet);
+      kind = boundary::none;
+      if(l_offset < size) {
+          if(s_scan_class_map.value[src[l_offset]] == scan_class_eol) {
+              kind = boundary::eol;
+          } else
+              kind = boundary::packet;
+      }
+      return l_offset;
+}
+
+const char* emc_get_scan_kernel_name() noexcept
+{
+      return s_scan_kernel.name;
+}
+
+/*namespace emc*/ }
@@ -0,0 +1,367 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "window.h"
+#include "config.h"
+#include <emc/error.h>
+
+namespace emc {
+
+/* emc_get_mark()
+   value of a `#HEX` argument, or -1 if the argument is not one
+*/
+static int  emc_get_mark(const std::string_view& arg, std::size_t size_max) noexcept
+{
+      int l_value = 0;
+      if((arg.size() < 2) ||
+          (arg.size() > size_max + 1) ||
+          (arg[0] != emc_tag_mark)) {
+          return -1;
+      }
+      for(std::size_t i_char = 1; i_char < arg.size(); i_char++) {
+          int l_digit = emc_get_hex(arg[i_char]);
+          if(l_digit < 0) {
+              return -1;
+          }
+          l_value = (l_value << 4) | l_digit;
+      }
+      return l_value;
+}
+
+/* emcwindow::request_t
+*/
+      emcwindow::request_t::request_t() noexcept:
+      wheel::entry(),
+      p_owner(nullptr),
+      p_context(nullptr),
+      m_id(0),
+      m_tag(0),
+      m_wait_bit(false),
+      m_late_bit(false)
+{
+}
+
+      emcwindow::request_t::~request_t()
+{
+}
+
+void  emcwindow::request_t::expire(std::uint64_t) noexcept
+{
+      p_owner->emi_expire(this);
+}
+
+/* emcwindow
+*/
+      emcwindow::emcwindow() noexcept:
+      p_reactor(nullptr),
+      m_order_list{},
+      m_free_bits(~std::uint64_t(0)),
+      m_order_head(0),
+      m_order_count(0),
+      m_window_size(1),
+      m_count(0),
+      m_wait_time(message_wait_time * 1000.0f),
+      m_drop_time(message_drop_time * 1000.0f),
+      m_tag_bit(false)
+{
+      for(int i_slot = 0; i_slot < window_size_max; i_slot++) {
+          m_request_list[i_slot].p_owner = this;
+          m_request_list[i_slot].m_tag = i_slot;
+      }
+}
+
+      emcwindow::~emcwindow()
+{
+      reset();
+}
+
+/* emi_expire()
+   the timeout of a request elapsed: in tag mode, the slot is released straight away - a late response would carry a
+   stale tag and be discarded; in order mode, the request stays queued (marked as late) for its response to still be
+   matched against it, until message_drop_time passes
+*/
+void  emcwindow::emi_expire(request_t* request_ptr) noexcept
+{
+      int   l_id = request_ptr->m_id;
+      void* l_context = request_ptr->p_context;
+      if(request_ptr->m_late_bit) {
+          emi_release(request_ptr);
+          return;
+      }
+      if(m_tag_bit) {
+          emi_release(request_ptr);
+      } else
+      if((p_reactor != nullptr) &&
+          (m_drop_time > m_wait_time)) {
+          request_ptr->m_late_bit = true;
+          p_reactor->schedule_after(request_ptr, m_drop_time - m_wait_time);
+      } else
+          emi_release(request_ptr);
+      emc_raw_expire(l_id, l_context);
+}
+
+/* emi_release()
+   return a request slot to the free list, advancing the generation bits of its tag
+*/
+void  emcwindow::emi_release(request_t* request_ptr) noexcept
+{
+      int l_slot = request_ptr->m_tag & tag_slot_mask;
+      request_ptr->cancel();
+      emi_order_remove(l_slot);
+      request_ptr->p_context = nullptr;
+      request_ptr->m_tag = (request_ptr->m_tag + (1 << tag_slot_bits)) & 0xff;
+      request_ptr->m_wait_bit = false;
+      request_ptr->m_late_bit = false;
+      m_free_bits |= std::uint64_t(1) << l_slot;
+      m_count--;
+}
+
+/* emi_order_remove()
+   remove a slot from the queue of outstanding requests; this is the head in all but the odd cases (out of order
+   responses in tag mode, dropped requests), so the queue is simply compacted
+*/
+void  emcwindow::emi_order_remove(int slot) noexcept
+{
+      int l_index = 0;
+      while(l_index < m_order_count) {
+          if(m_order_list[(m_order_head + l_index) % window_size_max] == slot) {
+              break;
+          }
+          l_index++;
+      }
+      if(l_index == 0) {
+          m_order_head = (m_order_head + 1) % window_size_max;
+      } else
+      if(l_index < m_order_count) {
+          for(int i_index = l_index + 1; i_index < m_order_count; i_index++) {
+              m_order_list[(m_order_head + i_index - 1) % window_size_max] =
+                  m_order_list[(m_order_head + i_index) % window_size_max];
+          }
+      } else
+          return;
+      m_order_count--;
+}
+
+/* emc_raw_expire()
+   called from within reactor::sync() when no response was received for a request in time
+*/
+void  emcwindow::emc_raw_expire(int, void*) noexcept
+{
+}
+
+/* bind()
+   set the reactor whose timing wheel drives the request timeouts; without one, requests never time out
+*/
+void  emcwindow::bind(reactor* reactor_ptr) noexcept
+{
+      reset();
+      p_reactor = reactor_ptr;
+}
+
+/* set_window_size()
+   set the number of requests allowed to be in flight at the same time; lowering the window does not affect the
+   requests already sent
+*/
+void  emcwindow::set_window_size(int size) noexcept
+{
+      if(size < 1) {
+          m_window_size = 1;
+      } else
+      if(size > window_size_max) {
+          m_window_size = window_size_max;
+      } else
+          m_window_size = size;
+}
+
+int   emcwindow::get_window_size() const noexcept
+{
+      return m_window_size;
+}
+
+/* set_tag_enabled()
+   switch between correlation by order and correlation by tag; meant to be set as the info exchange completes, before
+   any request is sent
+*/
+void  emcwindow::set_tag_enabled(bool value) noexcept
+{
+      m_tag_bit = value;
+}
+
+bool  emcwindow::get_tag_enabled() const noexcept
+{
+      return m_tag_bit;
+}
+
+/* set_timeout()
+   response timeout for the requests pushed from now on, in seconds
+*/
+void  emcwindow::set_timeout(float time) noexcept
+{
+      if(time > 0.0f) {
+          m_wait_time = time * 1000.0f;
+      } else
+          m_wait_time = 0u;
+}
+
+/* push()
+   register a request about to be sent; returns the tag the request needs to carry if tags are enabled, or err_fail if
+   the window is full
+*/
+int   emcwindow::push(int id, void* context) noexcept
+{
+      std::uint64_t l_free_bits = m_free_bits;
+      if(m_window_size < window_size_max) {
+          l_free_bits &= (std::uint64_t(1) << m_window_size) - 1u;
+      }
+      if(l_free_bits == 0u) {
+          return err_fail;
+      }
+      int        l_slot = __builtin_ctzll(l_free_bits);
+      request_t& l_request = m_request_list[l_slot];
+      l_request.p_context = context;
+      l_request.m_id = id;
+      l_request.m_wait_bit = true;
+      l_request.m_late_bit = false;
+      if(p_reactor != nullptr) {
+          if(m_wait_time > 0u) {
+              p_reactor->schedule_after(std::addressof(l_request), m_wait_time);
+          }
+      }
+      m_order_list[(m_order_head + m_order_count) % window_size_max] = l_slot;
+      m_order_count++;
+      m_free_bits &= ~(std::uint64_t(1) << l_slot);
+      m_count++;
+      return l_request.m_tag;
+}
+
+/* pop()
+   match a response against the outstanding requests: by its tag if tags are enabled, otherwise the oldest one; returns
+   false if there is no request to match or if the response came in for a request which already expired
+*/
+bool  emcwindow::pop(int tag, int& id, void*& context) noexcept
+{
+      request_t* l_request_ptr;
+      if(m_tag_bit) {
+          if((tag < 0) ||
+              (tag > 0xff)) {
+              return false;
+          }
+          l_request_ptr = std::addressof(m_request_list[tag & tag_slot_mask]);
+          if((l_request_ptr->m_wait_bit == false) ||
+              (l_request_ptr->m_tag != tag)) {
+              return false;
+          }
+      } else
+      if(m_order_count > 0) {
+          l_request_ptr = std::addressof(m_request_list[m_order_list[m_order_head]]);
+      } else
+          return false;
+      if(l_request_ptr->m_late_bit) {
+          emi_release(l_request_ptr);
+          return false;
+      }
+      id = l_request_ptr->m_id;
+      context = l_request_ptr->p_context;
+      emi_release(l_request_ptr);
+      return true;
+}
+
+bool  emcwindow::pop(const emcparser::item_t& item, int& id, void*& context) noexcept
+{
+      if(m_tag_bit) {
+          return pop(get_tag(item), id, context);
+      }
+      return pop(tag_none, id, context);
+}
+
+int   emcwindow::get_count() const noexcept
+{
+      return m_count;
+}
+
+bool  emcwindow::is_full() const noexcept
+{
+      std::uint64_t l_free_bits = m_free_bits;
+      if(m_window_size < window_size_max) {
+          l_free_bits &= (std::uint64_t(1) << m_window_size) - 1u;
+      }
+      return l_free_bits == 0u;
+}
+
+/* reset()
+   forget all the outstanding requests, without notice; for when the session drops
+*/
+void  emcwindow::reset() noexcept
+{
+      for(int i_slot = 0; i_slot < window_size_max; i_slot++) {
+          if(m_request_list[i_slot].m_wait_bit) {
+              emi_release(std::addressof(m_request_list[i_slot]));
+          }
+      }
+      m_order_head = 0;
+      m_order_count = 0;
+}
+
+/* make_tag()
+   print the `#TAG` argument for a request, returns its size (tag_size)
+*/
+int   emcwindow::make_tag(char* ptr, int tag) noexcept
+{
+      constexpr char l_hex_chs[] = "0123456789abcdef";
+      ptr[0] = emc_tag_mark;
+      ptr[1] = l_hex_chs[(tag >> 4) & 15];
+      ptr[2] = l_hex_chs[tag & 15];
+      return tag_size;
+}
+
+/* get_tag()
+   tag carried by a request or a response, as their first argument, tag_none if there is none
+*/
+int   emcwindow::get_tag(const emcparser::item_t& item) noexcept
+{
+      if(item.argc > 1) {
+          int l_tag = emc_get_mark(item.argv[1], tag_size - 1);
+          if(l_tag >= 0) {
+              return l_tag;
+          }
+      }
+      return tag_none;
+}
+
+/* get_info_window()
+   window advertised in an info request or response (`#WINDOW`, trailing the regular arguments), 0 if the peer did
+   not advertise one and thus only supports correlation by order
+*/
+int   emcwindow::get_info_window(const emcparser::item_t& item) noexcept
+{
+      for(int i_arg = 1; i_arg < item.argc; i_arg++) {
+          int l_window = emc_get_mark(item.argv[i_arg], tag_size - 1);
+          if(l_window > 0) {
+              if(l_window > window_size_max) {
+                  return window_size_max;
+              }
+              return l_window;
+          }
+      }
+      return 0;
+}
+
+/*namespace emc*/ }
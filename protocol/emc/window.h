@@ -0,0 +1,126 @@
+#ifndef emc_window_h
+#define emc_window_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/reactor.h>
+#include "parser.h"
+
+namespace emc {
+
+/* emcwindow
+   in-flight request tracker for the user role: lets up to `window size` requests be outstanding at the same time and
+   correlates the responses back to them, either
+   - by order: the default, and the only option with older peers - responses are assumed to come back in the order the
+     requests were sent, so each one completes the oldest outstanding request;
+   - by tag: once both ends agreed on it in the info exchange (`?i #WINDOW` answered by `]i ... #WINDOW`), requests
+     carry a tag as their first argument (`?RQID #TAG ...`) which the peer echoes back in the response
+     (`]RSID #TAG ...`), and responses may come back in any order.
+   Each request is given a timeout, tracked on the reactor timing wheel (and thus driven from reactor::sync()); when it
+   elapses, emc_raw_expire() is called. In order mode the expired request keeps its place in the queue until either its
+   late response arrives (and is discarded) or message_drop_time passes, so that the responses behind it are still
+   matched with the right requests.
+*/
+class emcwindow
+{
+  public:
+  static constexpr int  window_size_max = 64;
+  static constexpr int  tag_none = -1;
+  static constexpr int  tag_size = 3;
+
+  private:
+  static constexpr int  tag_slot_bits = 6;
+  static constexpr int  tag_slot_mask = (1 << tag_slot_bits) - 1;
+
+  static_assert(window_size_max <= (1 << tag_slot_bits), "tags can't address the whole window");
+
+  /* request_t
+  */
+  class request_t: public wheel::entry
+  {
+    emcwindow*      p_owner;
+    void*           p_context;
+    int             m_id;
+    int             m_tag;
+    bool            m_wait_bit;
+    bool            m_late_bit;
+
+    protected:
+    virtual void    expire(std::uint64_t) noexcept override;
+
+    friend class emcwindow;
+    public:
+            request_t() noexcept;
+            ~request_t();
+  };
+
+  private:
+  reactor*        p_reactor;
+  request_t       m_request_list[window_size_max];
+  std::uint8_t    m_order_list[window_size_max];
+  std::uint64_t   m_free_bits;
+  int             m_order_head;
+  int             m_order_count;
+  int             m_window_size;
+  int             m_count;
+  std::uint64_t   m_wait_time;
+  std::uint64_t   m_drop_time;
+  bool            m_tag_bit;
+
+  private:
+          void    emi_expire(request_t*) noexcept;
+          void    emi_release(request_t*) noexcept;
+          void    emi_order_remove(int) noexcept;
+
+  protected:
+  virtual void    emc_raw_expire(int, void*) noexcept;
+
+  public:
+          emcwindow() noexcept;
+          emcwindow(const emcwindow&) noexcept = delete;
+          emcwindow(emcwindow&&) noexcept = delete;
+  virtual ~emcwindow();
+
+          void    bind(reactor*) noexcept;
+          void    set_window_size(int) noexcept;
+          int     get_window_size() const noexcept;
+          void    set_tag_enabled(bool) noexcept;
+          bool    get_tag_enabled() const noexcept;
+          void    set_timeout(float) noexcept;
+
+          int     push(int, void* = nullptr) noexcept;
+          bool    pop(int, int&, void*&) noexcept;
+          bool    pop(const emcparser::item_t&, int&, void*&) noexcept;
+          int     get_count() const noexcept;
+          bool    is_full() const noexcept;
+          void    reset() noexcept;
+
+  static  int     make_tag(char*, int) noexcept;
+  static  int     get_tag(const emcparser::item_t&) noexcept;
+  static  int     get_info_window(const emcparser::item_t&) noexcept;
+
+          emcwindow& operator=(const emcwindow&) noexcept = delete;
+          emcwindow& operator=(emcwindow&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
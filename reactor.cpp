@@ -20,8 +20,10 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "reactor.h"
+#include "buffer.h"
 #include "event.h"
 #include "error.h"
+#include "config.h"
 
 constexpr std::uint8_t rem_none = 0u;
 constexpr std::uint8_t rem_suspend = 128u;
@@ -40,8 +42,22 @@ namespace emc {
       m_resume_bit(false),
       m_join_bit(false),
       m_open_bit(false),
-      m_record_enable(false)
-{
+      m_ring(ring_unknown),
+      m_record_enable(false),
+      m_event_queue(),
+      m_event_wake_bit(false),
+      m_scratch_arena(),
+      m_scratch_pool(queue_size_max, scratch_pool_depth),
+      m_dispatch_depth(0),
+      m_wheel(0u),
+      m_layer_map(),
+      m_clock_usec(0u)
+{
+#ifdef EMC_ENABLE_STATS
+      for(int i_slot = 0; i_slot < post_slot_count; i_slot++) {
+          m_post_count[i_slot].store(0u, std::memory_order_relaxed);
+      }
+#endif
 }
 
       reactor::~reactor()
@@ -78,6 +94,7 @@ void  reactor::sys_attach(stage* stage_ptr) noexcept
           p_stage_tail = stage_ptr;
       stage_ptr->p_stage_prev = p_stage_prev;
       stage_ptr->p_stage_next = p_stage_next;
+      stage_ptr->m_type = (stage_ptr->m_type & ~ring_bits) | get_ring();
 }
 
 bool  reactor::sys_resume_all() noexcept
@@ -91,18 +108,64 @@ bool  reactor::sys_resume_all() noexcept
           i_stage = i_stage->p_stage_next;
       }
       m_resume_bit = true;
+      sys_build_layers();
       return true;
 }
 
 void  reactor::sys_join_all() noexcept
 {
+      if(m_join_bit == false) {
+          stage* i_stage = p_stage_head;
+          m_join_bit = true;
+          while(i_stage != nullptr) {
+              i_stage->emc_raw_join();
+              i_stage = i_stage->p_stage_next;
+          }
+      }
 }
 
+/* sys_open_all()
+   signal every stage that the high level protocol negotiation succeeded; the ring both peers agreed on is passed
+   along in `flags` and is handed out to the stages before they are notified
+*/
+void  reactor::sys_open_all(const char* name, const char* version, unsigned int flags) noexcept
+{
+      if(m_open_bit == false) {
+          stage* i_stage = p_stage_head;
+          m_open_bit = true;
+          sys_set_ring(flags & ring_bits);
+          while(i_stage != nullptr) {
+              i_stage->emc_raw_proto_up(name, version, flags);
+              i_stage = i_stage->p_stage_next;
+          }
+      }
+}
+
+/* sys_set_ring()
+   write the ring into the flags of every stage, where get_ring_flags() picks it up from; each end does so on its own
+   when its handshake completes, with frames of the other framing possibly still in flight either way, so the stages
+   which frame differently within a ring mark their frames and take both kinds (see checksum, compress and uart)
+*/
+void  reactor::sys_set_ring(unsigned int ring) noexcept
+{
+      stage* i_stage = p_stage_head;
+      m_ring = ring;
+      while(i_stage != nullptr) {
+          i_stage->m_type = (i_stage->m_type & ~ring_bits) | ring;
+          i_stage = i_stage->p_stage_next;
+      }
+}
+
+/* sys_close()
+   the ring only holds for as long as the protocol session does: a stage falls back onto ring_unknown as soon as it is
+   notified that the session ended
+*/
 void  reactor::sys_close(stage* stage_ptr) noexcept
 {
       if(m_open_bit) {
           stage_ptr->emc_raw_proto_down();
       }
+      stage_ptr->m_type &= ~ring_bits;
 }
 
 void  reactor::sys_close_all() noexcept
@@ -182,6 +245,7 @@ void  reactor::sys_detach(stage* stage_ptr) noexcept
       sys_suspend_events(l_restore_events, rem_suspend);
       sys_record_events();
       stage_ptr->emc_raw_detach(this);
+      stage_ptr->m_type &= ~ring_bits;
       if(p_core_stage == stage_ptr) {
           p_core_stage = nullptr;
       }
@@ -203,6 +267,7 @@ void  reactor::sys_detach(stage* stage_ptr) noexcept
           p_stage_tail = stage_ptr->p_stage_prev;
       stage_ptr->p_stage_prev = nullptr;
       stage_ptr->p_stage_next = nullptr;
+      sys_build_layers();
       sys_delete_events();
       sys_restore_events(l_restore_events);
 }
@@ -217,6 +282,27 @@ void  reactor::sys_detach_all() noexcept
       m_resume_bit = false;
 }
 
+/* sys_build_layers()
+   rebuild the table mapping the layer names exposed by the stages onto the stages serving them; stages are walked
+   from head to tail, so a name exposed by more than one stage resolves to the one closest to the gate
+*/
+void  reactor::sys_build_layers() noexcept
+{
+      stage* i_stage = p_stage_head;
+      m_layer_map.clear();
+      while(i_stage != nullptr) {
+          for(int i_layer = 0; i_layer < service_count_max; i_layer++) {
+              const char* l_name = i_stage->get_layer_name(i_layer);
+              if(l_name == nullptr) {
+                  break;
+              }
+              m_layer_map.insert(l_name, i_stage, i_layer);
+          }
+          i_stage = i_stage->p_stage_next;
+      }
+      m_layer_map.build();
+}
+
 void  reactor::sys_sync_all(float dt) noexcept
 {
       stage* i_stage = p_stage_head;
@@ -249,6 +335,61 @@ void  reactor::sys_delete_events() noexcept
       m_record_enable = false;
 }
 
+/* sys_post_batch()
+   relay a batch of messages that was not handled as such as individual recv or send events
+*/
+int   reactor::sys_post_batch(event id, message_t* list, int count) noexcept
+{
+      int         l_result = err_not_required;
+      std::size_t l_mark = m_scratch_arena.get_mark();
+      for(int i_message = 0; i_message < count; i_message++) {
+          int  l_post_result;
+          auto l_message = list[i_message];
+          if(id == event::recv_batch) {
+              l_post_result = post(event::recv, event_info_t::for_recv(l_message.bus, l_message.data, l_message.size));
+          } else
+              l_post_result = post(event::send, event_info_t::for_send(l_message.bus, l_message.data, l_message.size));
+          m_scratch_arena.set_mark(l_mark);
+          if(l_post_result != err_not_required) {
+              if((l_result == err_not_required) ||
+                  (l_result == err_okay)) {
+                  l_result = l_post_result;
+              }
+          }
+      }
+      return l_result;
+}
+
+/* sys_get_buffer()
+   retrieve the buffer referenced by a recv or send event, if any
+*/
+buffer* reactor::sys_get_buffer(event id, const event_info_t& info) noexcept
+{
+      if(id == event::recv) {
+          return info.recv.buffer;
+      } else
+      if(id == event::send) {
+          return info.send.buffer;
+      }
+      return nullptr;
+}
+
+/* sys_dispatch_enter(), sys_dispatch_leave()
+   track nested dispatches into the pipeline; the scratch arena is rewound once the outermost dispatch returns (loops
+   dispatching several messages in a row also rewind it after each of them)
+*/
+void  reactor::sys_dispatch_enter() noexcept
+{
+      m_dispatch_depth++;
+}
+
+void  reactor::sys_dispatch_leave() noexcept
+{
+      if(--m_dispatch_depth == 0) {
+          m_scratch_arena.reset();
+      }
+}
+
 bool  reactor::emc_raw_resume() noexcept
 {
       return true;
@@ -257,7 +398,23 @@ bool  reactor::emc_raw_resume() noexcept
 int   reactor::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
 {
       if(p_stage_head != nullptr) {
-          return p_stage_head->emc_raw_recv(bus, data, size);
+          return p_stage_head->sys_recv(bus, data, size);
+      } else
+          return err_no_response;
+}
+
+int   reactor::emc_raw_recv_batch(message_t* list, int count) noexcept
+{
+      if(p_stage_head != nullptr) {
+          return p_stage_head->sys_recv_batch(list, count);
+      } else
+          return err_no_response;
+}
+
+int   reactor::emc_raw_recv_buffer(int bus, buffer* buffer) noexcept
+{
+      if(p_stage_head != nullptr) {
+          return p_stage_head->sys_recv_buffer(bus, buffer);
       } else
           return err_no_response;
 }
@@ -276,9 +433,30 @@ int   reactor::emc_raw_event(event, const event_info_t&) noexcept
       return err_not_required;
 }
 
+/* emc_raw_notify()
+   called on the posting thread when events are queued via post_async(), for the engines to wake up the reactor thread;
+   without an engine, queued events are only picked up on the next sync()
+*/
+void  reactor::emc_raw_notify() noexcept
+{
+}
+
+/* pod_resume()
+   the scratch arena is sized for the stage chain here, as every stage attached by then may hold a copy of the message
+   during a nested dispatch
+*/
 bool  reactor::pod_resume() noexcept
 {
       if(m_resume_bit == false) {
+          std::size_t l_scratch_size = scratch_arena_size;
+          stage*      i_stage = p_stage_head;
+          while(i_stage != nullptr) {
+              l_scratch_size += scratch_stage_size;
+              i_stage = i_stage->p_stage_next;
+          }
+          if(m_scratch_arena.reserve(l_scratch_size) == false) {
+              return false;
+          }
           if(sys_resume_all() == false) {
               return false;
           }
@@ -311,6 +489,7 @@ bool  reactor::pod_attach_stage(stage* stage_ptr) noexcept
               sys_suspend_events(l_restore_events, rem_suspend);
               stage_ptr->p_owner = this;
               stage_ptr->emc_raw_attach(this);
+              sys_build_layers();
               if(m_resume_bit) {
                   if(stage_ptr->emc_raw_resume(this)) {
                       if(m_join_bit) {
@@ -355,6 +534,108 @@ bool  reactor::pod_suspend(bool send_suspend_event) noexcept
       return m_resume_bit == false;
 }
 
+/* pod_open()
+   called once the peers completed the protocol handshake; `flags` carry the ring they agreed on, i.e. the outermost of
+   the rings each of them placed the other in
+*/
+bool  reactor::pod_open(const char* name, const char* version, unsigned int flags) noexcept
+{
+      if(m_resume_bit) {
+          sys_join_all();
+          sys_open_all(name, version, flags);
+          return true;
+      }
+      return false;
+}
+
+/* pod_close()
+   called when the protocol session ended, without the reactor dropping from the network
+*/
+void  reactor::pod_close() noexcept
+{
+      sys_close_all();
+}
+
+/* pod_drain_queue()
+   run the events queued from other threads; called on the reactor thread
+*/
+int   reactor::pod_drain_queue() noexcept
+{
+      event_record_t l_record;
+      buffer*        l_buffer;
+      unsigned int   l_count = 0u;
+      std::size_t    l_mark;
+      // clear the wake bit first: anything queued from now on will trigger another notification
+      m_event_wake_bit.store(false, std::memory_order_seq_cst);
+      sys_dispatch_enter();
+      l_mark = m_scratch_arena.get_mark();
+      while(l_count < event_queue_size) {
+          if(m_event_queue.pop(l_record) == false) {
+              sys_dispatch_leave();
+              return l_count;
+          }
+          post(l_record.id, l_record.info);
+          // each event gets the whole scratch arena, rather than whatever the events before it left over
+          m_scratch_arena.set_mark(l_mark);
+          l_buffer = sys_get_buffer(l_record.id, l_record.info);
+          if(l_buffer != nullptr) {
+              l_buffer->release();
+          }
+          l_count++;
+      }
+      sys_dispatch_leave();
+      // batch limit reached, reschedule for the remaining events
+      if(m_event_wake_bit.exchange(true, std::memory_order_seq_cst) == false) {
+          emc_raw_notify();
+      }
+      return l_count;
+}
+
+/* pod_recv()
+   dispatch a received message into the pipeline; engines should use this (or the batch and buffer variants) rather than
+   calling into emc_raw_recv() directly, so that the scratch memory handed out to the stages is reclaimed afterwards
+*/
+int   reactor::pod_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      int  l_result;
+      sys_dispatch_enter();
+      l_result = emc_raw_recv(bus, data, size);
+      sys_dispatch_leave();
+      return l_result;
+}
+
+int   reactor::pod_recv_batch(message_t* list, int count) noexcept
+{
+      int  l_result;
+      sys_dispatch_enter();
+      l_result = emc_raw_recv_batch(list, count);
+      sys_dispatch_leave();
+      return l_result;
+}
+
+int   reactor::pod_recv_buffer(int bus, buffer* buffer) noexcept
+{
+      int  l_result;
+      sys_dispatch_enter();
+      l_result = emc_raw_recv_buffer(bus, buffer);
+      sys_dispatch_leave();
+      return l_result;
+}
+
+/* pod_get_block(), pod_put_block()
+   blocks from the reactor pool, for data the engines need to hold on to past the current dispatch (i.e. output
+   pending on a bus); same rules as stage::emc_get_block()
+*/
+auto  reactor::pod_get_block(std::size_t size) noexcept -> std::uint8_t*
+{
+      return m_scratch_pool.get(size);
+}
+
+void  reactor::pod_put_block(std::uint8_t* data, std::size_t size) noexcept
+{
+      m_scratch_pool.put(data, size);
+}
+
 void  reactor::feed(int) noexcept
 {
 }
@@ -365,9 +646,23 @@ void  reactor::hup(int) noexcept
 
 int   reactor::post(event id, const event_info_t& info) noexcept
 {
+#ifdef EMC_ENABLE_STATS
+      int  l_slot = static_cast<int>(id);
+      if((l_slot < 0) ||
+          (l_slot >= post_slot_count)) {
+          l_slot = post_slot_count - 1;
+      }
+      m_post_count[l_slot].store(m_post_count[l_slot].load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+#endif
       int l_result = emc_raw_event(id, info);
       if(l_result == err_not_required) {
           switch(id) {
+            case event::recv_batch:
+                l_result = sys_post_batch(id, info.recv_batch.list, info.recv_batch.count);
+                break;
+            case event::send_batch:
+                l_result = sys_post_batch(id, info.send_batch.list, info.send_batch.count);
+                break;
             case event::drop:
             case event::hup:
             case event::abort:
@@ -392,10 +687,153 @@ int   reactor::post(event id, const event_info_t& info) noexcept
       return l_result;
 }
 
+/* post_async()
+   queue an event to be posted on the reactor thread; safe to call from any thread;
+   any data referenced by the event info must remain valid until the event is processed, except for recv and send events
+   carrying a buffer, which is held by the queue for as long as needed
+*/
+int   reactor::post_async(event id, const event_info_t& info) noexcept
+{
+      event_record_t l_record;
+      buffer*        l_buffer = sys_get_buffer(id, info);
+      l_record.id = id;
+      l_record.info = info;
+      if(l_buffer != nullptr) {
+          l_buffer->acquire();
+      }
+      if(m_event_queue.push(l_record) == false) {
+          if(l_buffer != nullptr) {
+              l_buffer->release();
+          }
+          return err_fail;
+      }
+      if(m_event_wake_bit.exchange(true, std::memory_order_seq_cst) == false) {
+          emc_raw_notify();
+      }
+      return err_okay;
+}
+
+/* sync()
+   periodic update: run the queued events, advance the reactor clock by `dt` seconds and expire the due wheel entries,
+   then pass the update on to the stages
+*/
 void  reactor::sync(float dt) noexcept
 {
+      pod_drain_queue();
+      sys_dispatch_enter();
+      if(dt > 0.0f) {
+          m_clock_usec += static_cast<std::uint64_t>(dt * 1000000.0f + 0.5f);
+      }
+      m_wheel.advance(get_clock());
       sys_sync_all(dt);
       emc_raw_sync(dt);
+      sys_dispatch_leave();
+}
+
+/* get_ring()
+   ring negotiated with the peer for the current protocol session, ring_unknown if there is none
+*/
+unsigned int reactor::get_ring() const noexcept
+{
+      if(m_open_bit) {
+          return m_ring;
+      }
+      return ring_unknown;
+}
+
+/* find_layer()
+   lookup the stage serving the layer with the given name; the table is rebuilt whenever stages are attached,
+   detached or resumed
+*/
+auto  reactor::find_layer(const char* name, std::size_t size) const noexcept -> const dispatch::entry_t*
+{
+      return m_layer_map.find(name, size);
+}
+
+auto  reactor::find_layer(const char* name) const noexcept -> const dispatch::entry_t*
+{
+      return m_layer_map.find(name);
+}
+
+/* get_clock()
+   monotonic reactor time, in milliseconds, as accumulated by sync()
+*/
+std::uint64_t reactor::get_clock() const noexcept
+{
+      return m_clock_usec / 1000u;
+}
+
+/* schedule()
+   arm a wheel entry to expire once the reactor clock reaches the given time (in milliseconds); entries expire on the
+   reactor thread, from within sync()
+*/
+void  reactor::schedule(wheel::entry* entry_ptr, std::uint64_t time) noexcept
+{
+      m_wheel.schedule(entry_ptr, time);
+}
+
+/* schedule_after()
+   arm a wheel entry to expire after the given interval (in milliseconds) has passed
+*/
+void  reactor::schedule_after(wheel::entry* entry_ptr, std::uint64_t interval) noexcept
+{
+      m_wheel.schedule(entry_ptr, get_clock() + interval);
+}
+
+/* get_post_count()
+   number of times the given event was posted onto the reactor; user events are counted together, under
+   event::user_base; may be called from any thread
+*/
+std::uint64_t reactor::get_post_count(event id) const noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      int  l_slot = static_cast<int>(id);
+      if((l_slot < 0) ||
+          (l_slot >= post_slot_count)) {
+          l_slot = post_slot_count - 1;
+      }
+      return m_post_count[l_slot].load(std::memory_order_relaxed);
+#else
+      static_cast<void>(id);
+      return 0u;
+#endif
+}
+
+/* get_stats()
+   snapshot the counters of the stages in the pipeline, in pipeline order, into `list`; returns the number of stages
+   written; may be called from any thread while messages are being processed, but not concurrently with attaching or
+   detaching stages
+*/
+int   reactor::get_stats(stage_stats_t* list, int count) const noexcept
+{
+      int    l_count = 0;
+      stage* i_stage = p_stage_head;
+      if constexpr (stats_enabled) {
+          while((i_stage != nullptr) &&
+              (l_count < count)) {
+              i_stage->get_stats(list[l_count]);
+              i_stage = i_stage->p_stage_next;
+              l_count++;
+          }
+      }
+      return l_count;
+}
+
+/* reset_stats()
+   clear the event and stage counters; reactor thread only
+*/
+void  reactor::reset_stats() noexcept
+{
+      stage* i_stage = p_stage_head;
+#ifdef EMC_ENABLE_STATS
+      for(int i_slot = 0; i_slot < post_slot_count; i_slot++) {
+          m_post_count[i_slot].store(0u, std::memory_order_relaxed);
+      }
+#endif
+      while(i_stage != nullptr) {
+          i_stage->reset_stats();
+          i_stage = i_stage->p_stage_next;
+      }
 }
 
 /*namespace emc*/ }
@@ -23,6 +23,11 @@
 **/
 #include "emc.h"
 #include "stage.h"
+#include "etc/arena.h"
+#include "etc/pool.h"
+#include "etc/mpsc.h"
+#include "etc/wheel.h"
+#include "etc/dispatch.h"
 
 namespace emc {
 
@@ -32,6 +37,16 @@ namespace emc {
 */
 class reactor
 {
+  public:
+  static constexpr unsigned int event_queue_size = 64;
+  static constexpr int          post_slot_count = static_cast<int>(event::user_base) + 1;
+
+  private:
+  struct event_record_t {
+    event         id;
+    event_info_t  info;
+  };
+
   stage*        p_stage_head;
   stage*        p_stage_tail;
 
@@ -47,13 +62,26 @@ class reactor
   bool          m_open_bit;
 
   private:
+  unsigned int  m_ring;
   bool          m_record_enable;
+  mpsc<event_record_t, event_queue_size> m_event_queue;
+  std::atomic<bool> m_event_wake_bit;
+  arena         m_scratch_arena;
+  pool          m_scratch_pool;
+  int           m_dispatch_depth;
+  wheel         m_wheel;
+  dispatch      m_layer_map;
+  std::uint64_t m_clock_usec;
+#ifdef EMC_ENABLE_STATS
+  std::atomic<std::uint64_t> m_post_count[post_slot_count];
+#endif
 
   private:
           void  sys_attach(stage*) noexcept;
           bool  sys_resume_all() noexcept;
           void  sys_join_all() noexcept;
-          void  sys_open_all() noexcept;
+          void  sys_open_all(const char*, const char*, unsigned int) noexcept;
+          void  sys_set_ring(unsigned int) noexcept;
           void  sys_close(stage*) noexcept;
           void  sys_close_all() noexcept;
           void  sys_drop(stage*) noexcept;
@@ -63,26 +91,44 @@ class reactor
           void  sys_suspend_all(stage*) noexcept;
           void  sys_detach(stage*) noexcept;
           void  sys_detach_all() noexcept;
+          void  sys_build_layers() noexcept;
           void  sys_sync_all(float) noexcept;
 
           void  sys_suspend_events(std::uint8_t&, std::uint8_t) noexcept;
           void  sys_restore_events(std::uint8_t&) noexcept;
           void  sys_record_events() noexcept;
           void  sys_delete_events() noexcept;
+          int   sys_post_batch(event, message_t*, int) noexcept;
+  static  buffer* sys_get_buffer(event, const event_info_t&) noexcept;
+          void  sys_dispatch_enter() noexcept;
+          void  sys_dispatch_leave() noexcept;
 
   protected:
   virtual bool  emc_raw_resume() noexcept;
-          int   emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept;
+  virtual int   emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept;
+  virtual int   emc_raw_recv_batch(message_t*, int) noexcept;
+  virtual int   emc_raw_recv_buffer(int, buffer*) noexcept;
   virtual bool  emc_raw_suspend() noexcept;
   virtual void  emc_raw_sync(float) noexcept;
   virtual int   emc_raw_event(event, const event_info_t&) noexcept;
+  virtual void  emc_raw_notify() noexcept;
 
           bool  pod_resume() noexcept;
           bool  pod_attach_stage(stage*) noexcept;
           bool  pod_detach_stage(stage*) noexcept;
           bool  pod_suspend(bool = true) noexcept;
+          bool  pod_open(const char*, const char*, unsigned int) noexcept;
+          void  pod_close() noexcept;
+          int   pod_drain_queue() noexcept;
+          int   pod_recv(int, std::uint8_t*, std::size_t) noexcept;
+          int   pod_recv_batch(message_t*, int) noexcept;
+          int   pod_recv_buffer(int, buffer*) noexcept;
+          auto  pod_get_block(std::size_t) noexcept -> std::uint8_t*;
+          void  pod_put_block(std::uint8_t*, std::size_t) noexcept;
 
   friend class stage;
+  template<typename, typename...>
+  friend class static_pipeline;
   public:
           reactor() noexcept;
           reactor(const reactor&) noexcept = delete;
@@ -92,8 +138,20 @@ class reactor
   virtual void      feed(int) noexcept;
   virtual void      hup(int) noexcept;
           int       post(event, const event_info_t&) noexcept;
+          int       post_async(event, const event_info_t&) noexcept;
           void      sync(float) noexcept;
 
+          unsigned int get_ring() const noexcept;
+  const   dispatch::entry_t* find_layer(const char*, std::size_t) const noexcept;
+  const   dispatch::entry_t* find_layer(const char*) const noexcept;
+          std::uint64_t get_clock() const noexcept;
+          void      schedule(wheel::entry*, std::uint64_t) noexcept;
+          void      schedule_after(wheel::entry*, std::uint64_t) noexcept;
+
+          std::uint64_t get_post_count(event) const noexcept;
+          int       get_stats(stage_stats_t*, int) const noexcept;
+          void      reset_stats() noexcept;
+
           reactor&  operator=(const reactor&) noexcept = delete;
           reactor&  operator=(reactor&&) noexcept = delete;
 };
@@ -21,6 +21,7 @@
 **/
 #include "stage.h"
 #include "reactor.h"
+#include "buffer.h"
 
 namespace emc {
 
@@ -29,6 +30,10 @@ namespace emc {
       stage::stage(unsigned int type) noexcept:
       p_stage_prev(nullptr),
       p_stage_next(nullptr),
+#ifdef EMC_ENABLE_STATS
+      m_recv_probe(),
+      m_send_probe(),
+#endif
       p_owner(nullptr),
       m_type(type)
 {
@@ -41,11 +46,175 @@ namespace emc {
       }
 }
 
+/* sys_recv(), sys_send()
+   invoke the stage callbacks on behalf of the previous/next stage in the pipeline, or of the reactor, and account for
+   them in the stage probes if statistics are enabled
+*/
+int   stage::sys_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::uint64_t l_tick = probe::get_tick();
+      int           l_result = emc_raw_recv(bus, data, size);
+      m_recv_probe.record(1u, size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_recv(bus, data, size);
+#endif
+}
+
+int   stage::sys_send(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::uint64_t l_tick = probe::get_tick();
+      int           l_result = emc_raw_send(bus, data, size);
+      m_send_probe.record(1u, size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_send(bus, data, size);
+#endif
+}
+
+int   stage::sys_recv_batch(message_t* list, int count) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::size_t   l_size = 0u;
+      std::uint64_t l_tick;
+      int           l_result;
+      for(int i_message = 0; i_message < count; i_message++) {
+          l_size += list[i_message].size;
+      }
+      l_tick = probe::get_tick();
+      l_result = emc_raw_recv_batch(list, count);
+      m_recv_probe.record(count, l_size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_recv_batch(list, count);
+#endif
+}
+
+int   stage::sys_send_batch(message_t* list, int count) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::size_t   l_size = 0u;
+      std::uint64_t l_tick;
+      int           l_result;
+      for(int i_message = 0; i_message < count; i_message++) {
+          l_size += list[i_message].size;
+      }
+      l_tick = probe::get_tick();
+      l_result = emc_raw_send_batch(list, count);
+      m_send_probe.record(count, l_size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_send_batch(list, count);
+#endif
+}
+
+int   stage::sys_recv_buffer(int bus, buffer* buffer) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::size_t   l_size = buffer->get_size();
+      std::uint64_t l_tick = probe::get_tick();
+      int           l_result = emc_raw_recv_buffer(bus, buffer);
+      m_recv_probe.record(1u, l_size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_recv_buffer(bus, buffer);
+#endif
+}
+
+int   stage::sys_send_buffer(int bus, buffer* buffer) noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      std::size_t   l_size = buffer->get_size();
+      std::uint64_t l_tick = probe::get_tick();
+      int           l_result = emc_raw_send_buffer(bus, buffer);
+      m_send_probe.record(1u, l_size, l_result, probe::get_tick() - l_tick);
+      return l_result;
+#else
+      return emc_raw_send_buffer(bus, buffer);
+#endif
+}
+
 auto  stage::emc_get_owner() noexcept -> reactor*
 {
       return p_owner;
 }
 
+/* emc_get_scratch()
+   borrow scratch memory from the owner reactor; the memory is only valid until the current emc_raw_recv()/emc_raw_send()
+   dispatch returns, and must not be freed; returns nullptr if the stage is detached or the arena is exhausted
+*/
+auto  stage::emc_get_scratch(std::size_t size) noexcept -> std::uint8_t*
+{
+      if(p_owner != nullptr) {
+          return p_owner->m_scratch_arena.get(size);
+      }
+      return nullptr;
+}
+
+/* emc_get_block()
+   obtain a block from the owner reactor's pool, for data that needs to outlive the current dispatch; the block must be
+   given back via emc_put_block() with the same size, while still attached onto the same reactor
+*/
+auto  stage::emc_get_block(std::size_t size) noexcept -> std::uint8_t*
+{
+      if(p_owner != nullptr) {
+          return p_owner->m_scratch_pool.get(size);
+      }
+      return nullptr;
+}
+
+void  stage::emc_put_block(std::uint8_t* data, std::size_t size) noexcept
+{
+      if(p_owner != nullptr) {
+          p_owner->m_scratch_pool.put(data, size);
+      }
+}
+
+/* emc_get_scratch_mark(), emc_set_scratch_mark()
+   save and restore the allocation point of the scratch memory, for loops that dispatch several messages within the
+   same dispatch to give back what was taken for each of them
+*/
+auto  stage::emc_get_scratch_mark() noexcept -> std::size_t
+{
+      if(p_owner != nullptr) {
+          return p_owner->m_scratch_arena.get_mark();
+      }
+      return 0u;
+}
+
+void  stage::emc_set_scratch_mark(std::size_t mark) noexcept
+{
+      if(p_owner != nullptr) {
+          p_owner->m_scratch_arena.set_mark(mark);
+      }
+}
+
+/* emc_proto_up()
+   to be called by the stage that carries out the protocol handshake, once it succeeded; `flags` may carry the ring
+   agreed on with the peer, which is then made available to every stage via get_ring_flags()
+   the engines do not work out a ring of their own: the handshake stage has to OR the ring bits into `flags` itself, or
+   the session runs as ring_unknown and no stage steps aside
+*/
+bool  stage::emc_proto_up(const char* name, const char* version, unsigned int flags) noexcept
+{
+      if(p_owner != nullptr) {
+          return p_owner->pod_open(name, version, flags);
+      }
+      return false;
+}
+
+/* emc_proto_down()
+   to be called by the stage that carries out the protocol handshake when the session ends
+*/
+void  stage::emc_proto_down() noexcept
+{
+      if(p_owner != nullptr) {
+          p_owner->pod_close();
+      }
+}
+
 /* emc_raw_attach()
    called when the stage is attached onto a pipeline
 */
@@ -83,7 +252,7 @@ void  stage::emc_raw_proto_up(const char*, const char*, unsigned int) noexcept
 int   stage::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
 {
       if(p_stage_next != nullptr) {
-          return p_stage_next->emc_raw_recv(bus, data, size);
+          return p_stage_next->sys_recv(bus, data, size);
       }
       if(p_owner != nullptr) {
           int  l_result = err_fail;
@@ -108,7 +277,7 @@ int   stage::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcep
 int   stage::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept
 {
       if(p_stage_prev != nullptr) {
-          return p_stage_prev->emc_raw_send(bus, data, size);
+          return p_stage_prev->sys_send(bus, data, size);
       }
       if(p_owner != nullptr) {
           int  l_result = err_fail;
@@ -125,6 +294,148 @@ int   stage::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcep
       return err_okay;
 }
 
+/* emc_raw_recv_batch()
+   forward path chained call for a batch of messages; the default implementation falls back to emc_raw_recv() for each
+   message, stages that are able to handle a whole batch at once should override it and pass the batch along via
+   emc_raw_forward_batch(); the scratch memory taken while handling each message is given back before the next one;
+   current stage is allowed to modify the message descriptors, or to remove some of them from the batch.
+*/
+int   stage::emc_raw_recv_batch(message_t* list, int count) noexcept
+{
+      int         l_result = err_okay;
+      std::size_t l_mark = emc_get_scratch_mark();
+      for(int i_message = 0; i_message < count; i_message++) {
+          int l_recv_result = emc_raw_recv(list[i_message].bus, list[i_message].data, list[i_message].size);
+          emc_set_scratch_mark(l_mark);
+          if(l_recv_result != err_okay) {
+              if(l_result == err_okay) {
+                  l_result = l_recv_result;
+              }
+          }
+      }
+      return l_result;
+}
+
+/* emc_raw_send_batch()
+   return path chained call for a batch of messages; same as emc_raw_recv_batch(), falls back to emc_raw_send() for
+   each message by default
+*/
+int   stage::emc_raw_send_batch(message_t* list, int count) noexcept
+{
+      int         l_result = err_okay;
+      std::size_t l_mark = emc_get_scratch_mark();
+      for(int i_message = 0; i_message < count; i_message++) {
+          int l_send_result = emc_raw_send(list[i_message].bus, list[i_message].data, list[i_message].size);
+          emc_set_scratch_mark(l_mark);
+          if(l_send_result != err_okay) {
+              if(l_result == err_okay) {
+                  l_result = l_send_result;
+              }
+          }
+      }
+      return l_result;
+}
+
+/* emc_raw_forward_batch()
+   pass a batch of messages on to the next stage, or to the reactor if this is the last stage in the pipeline
+*/
+int   stage::emc_raw_forward_batch(message_t* list, int count) noexcept
+{
+      if(count > 0) {
+          if(p_stage_next != nullptr) {
+              return p_stage_next->sys_recv_batch(list, count);
+          }
+          if(p_owner != nullptr) {
+              int  l_result = p_owner->post(event::recv_batch, event_info_t::for_recv_batch(list, count));
+              if((l_result == err_okay) ||
+                  (l_result == err_not_required)) {
+                  l_result = err_okay;
+              }
+              return l_result;
+          }
+      }
+      return err_okay;
+}
+
+/* emc_raw_return_batch()
+   pass a batch of messages on to the previous stage, or to the reactor if this is the first stage in the pipeline
+*/
+int   stage::emc_raw_return_batch(message_t* list, int count) noexcept
+{
+      if(count > 0) {
+          if(p_stage_prev != nullptr) {
+              return p_stage_prev->sys_send_batch(list, count);
+          }
+          if(p_owner != nullptr) {
+              int  l_result = p_owner->post(event::send_batch, event_info_t::for_send_batch(list, count));
+              if((l_result == err_okay) ||
+                  (l_result == err_not_required)) {
+                  l_result = err_okay;
+              }
+              return l_result;
+          }
+      }
+      return err_okay;
+}
+
+/* emc_raw_recv_buffer()
+   forward path chained call for a message held in a reference counted buffer; the default implementation falls back to
+   emc_raw_recv() on the payload, which ends the buffer path for the rest of the pipeline; stages that are able to work
+   on the buffer in place should override it and pass the buffer along via emc_raw_forward_buffer();
+   the buffer reference belongs to the caller, stages that need to keep the message past the call must acquire() it.
+*/
+int   stage::emc_raw_recv_buffer(int bus, buffer* buffer) noexcept
+{
+      return emc_raw_recv(bus, buffer->get_data(), buffer->get_size());
+}
+
+/* emc_raw_send_buffer()
+   return path chained call for a message held in a reference counted buffer; same as emc_raw_recv_buffer(), falls back
+   to emc_raw_send() by default
+*/
+int   stage::emc_raw_send_buffer(int bus, buffer* buffer) noexcept
+{
+      return emc_raw_send(bus, buffer->get_data(), buffer->get_size());
+}
+
+/* emc_raw_forward_buffer()
+   pass a buffer on to the next stage, or to the reactor if this is the last stage in the pipeline
+*/
+int   stage::emc_raw_forward_buffer(int bus, buffer* buffer) noexcept
+{
+      if(p_stage_next != nullptr) {
+          return p_stage_next->sys_recv_buffer(bus, buffer);
+      }
+      if(p_owner != nullptr) {
+          int  l_result = p_owner->post(event::recv, event_info_t::for_recv(bus, buffer));
+          if((l_result == err_okay) ||
+              (l_result == err_not_required)) {
+              l_result = err_okay;
+          }
+          return l_result;
+      }
+      return err_okay;
+}
+
+/* emc_raw_return_buffer()
+   pass a buffer on to the previous stage, or to the reactor if this is the first stage in the pipeline
+*/
+int   stage::emc_raw_return_buffer(int bus, buffer* buffer) noexcept
+{
+      if(p_stage_prev != nullptr) {
+          return p_stage_prev->sys_send_buffer(bus, buffer);
+      }
+      if(p_owner != nullptr) {
+          int  l_result = p_owner->post(event::send, event_info_t::for_send(bus, buffer));
+          if((l_result == err_okay) ||
+              (l_result == err_not_required)) {
+              l_result = err_okay;
+          }
+          return l_result;
+      }
+      return err_okay;
+}
+
 /* emc_raw_proto_down()
    triggered for every stage when the high level protocol communication fails or it's suspended
 */
@@ -225,8 +536,8 @@ bool  stage::has_type(unsigned int type) const noexcept
 */
 bool  stage::has_type(unsigned int kind_range_min, unsigned int kind_range_max) const noexcept
 {
-      if((m_type >= kind_range_min) &&
-          (m_type <= kind_range_max)) {
+      if(((m_type & stage_type_bits) >= kind_range_min) &&
+          ((m_type & stage_type_bits) <= kind_range_max)) {
           return true;
       }
       return false;
@@ -236,7 +547,7 @@ bool  stage::has_type(unsigned int kind_range_min, unsigned int kind_range_max)
 */
 auto  stage::get_type() const noexcept -> unsigned int
 {
-      return m_type;
+      return m_type & stage_type_bits;
 }
 
 /* get_layer_name()
@@ -246,6 +557,14 @@ auto  stage::get_layer_name(int) const noexcept -> const char*
       return nullptr;
 }
 
+/* has_ring()
+   test whether the peer is known to be at least as close as `ring`
+*/
+bool  stage::has_ring(unsigned int ring) const noexcept
+{
+      return (m_type & ring_bits) >= ring;
+}
+
 /* get_layer_flags()
 */
 bool  stage::has_ring_flags(unsigned int flags) const noexcept
@@ -266,6 +585,32 @@ void  stage::describe() noexcept
 {
 }
 
+/* get_stats()
+   snapshot of the stage counters; may be called from any thread while the pipeline is running; returns false (and an
+   empty snapshot) if the library was built without EMC_ENABLE_STATS
+*/
+bool  stage::get_stats(stage_stats_t& stats) const noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      m_recv_probe.get(stats.recv);
+      m_send_probe.get(stats.send);
+      return true;
+#else
+      std::memset(std::addressof(stats), 0, sizeof(stage_stats_t));
+      return false;
+#endif
+}
+
+/* reset_stats()
+*/
+void  stage::reset_stats() noexcept
+{
+#ifdef EMC_ENABLE_STATS
+      m_recv_probe.reset();
+      m_send_probe.reset();
+#endif
+}
+
 /* sync()
 */
 void  stage::sync(float dt) noexcept
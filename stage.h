@@ -24,6 +24,7 @@
 #include "emc.h"
 #include "error.h"
 #include "event.h"
+#include "stats.h"
 
 namespace emc {
 
@@ -31,6 +32,18 @@ class stage
 {
   stage*        p_stage_prev;
   stage*        p_stage_next;
+#ifdef EMC_ENABLE_STATS
+  probe         m_recv_probe;
+  probe         m_send_probe;
+#endif
+
+  private:
+          int   sys_recv(int, std::uint8_t*, std::size_t) noexcept;
+          int   sys_send(int, std::uint8_t*, std::size_t) noexcept;
+          int   sys_recv_batch(message_t*, int) noexcept;
+          int   sys_send_batch(message_t*, int) noexcept;
+          int   sys_recv_buffer(int, buffer*) noexcept;
+          int   sys_send_buffer(int, buffer*) noexcept;
 
   public:
   enum class role {
@@ -46,12 +59,27 @@ class stage
 
   protected:
           auto  emc_get_owner() noexcept -> reactor*;
+          auto  emc_get_scratch(std::size_t) noexcept -> std::uint8_t*;
+          auto  emc_get_block(std::size_t) noexcept -> std::uint8_t*;
+          void  emc_put_block(std::uint8_t*, std::size_t) noexcept;
+          auto  emc_get_scratch_mark() noexcept -> std::size_t;
+          void  emc_set_scratch_mark(std::size_t) noexcept;
+          bool  emc_proto_up(const char*, const char*, unsigned int) noexcept;    // the caller ORs the ring bits into the flags
+          void  emc_proto_down() noexcept;
   virtual void  emc_raw_attach(reactor*) noexcept;
   virtual bool  emc_raw_resume(reactor*) noexcept;
   virtual void  emc_raw_join() noexcept;
   virtual void  emc_raw_proto_up(const char*, const char*, unsigned int) noexcept;
   virtual int   emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept;
   virtual int   emc_raw_send(int, std::uint8_t*, std::size_t) noexcept;
+  virtual int   emc_raw_recv_batch(message_t*, int) noexcept;
+  virtual int   emc_raw_send_batch(message_t*, int) noexcept;
+          int   emc_raw_forward_batch(message_t*, int) noexcept;
+          int   emc_raw_return_batch(message_t*, int) noexcept;
+  virtual int   emc_raw_recv_buffer(int, buffer*) noexcept;
+  virtual int   emc_raw_send_buffer(int, buffer*) noexcept;
+          int   emc_raw_forward_buffer(int, buffer*) noexcept;
+          int   emc_raw_return_buffer(int, buffer*) noexcept;
   virtual void  emc_raw_proto_down() noexcept;
   virtual void  emc_raw_drop() noexcept;
   virtual void  emc_raw_suspend(reactor*) noexcept;
@@ -60,6 +88,8 @@ class stage
           void  emc_raw_post(event) noexcept;
   virtual int   emc_raw_post(event, const event_info_t&) noexcept;
   friend  class reactor;
+  template<typename, typename...>
+  friend  class static_pipeline;
 
   public:
           stage(unsigned int = stage_type_generic) noexcept;
@@ -78,9 +108,12 @@ class stage
           unsigned int get_type() const noexcept;
 
   virtual const char*  get_layer_name(int) const noexcept;
+          bool         has_ring(unsigned int) const noexcept;
           bool         has_ring_flags(unsigned int) const noexcept;
           unsigned int get_ring_flags() const noexcept;
   virtual void         describe() noexcept;
+          bool         get_stats(stage_stats_t&) const noexcept;
+          void         reset_stats() noexcept;
 
           void         sync(float) noexcept;
 
@@ -0,0 +1,275 @@
+#ifndef emc_static_pipeline_h
+#define emc_static_pipeline_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+#include "error.h"
+#include "stage.h"
+#include "reactor.h"
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace emc {
+
+/* has_static_recv, has_static_send
+   detect whether a stage type provides the compile time hooks used by static_pipeline
+*/
+template<typename Xt, typename = void>
+struct has_static_recv: std::false_type {};
+
+template<typename Xt>
+struct has_static_recv<Xt, std::void_t<decltype(std::declval<Xt&>().emc_static_recv(std::declval<int&>(), std::declval<std::uint8_t*&>(), std::declval<std::size_t&>()))>>: std::true_type {};
+
+template<typename Xt, typename = void>
+struct has_static_send: std::false_type {};
+
+template<typename Xt>
+struct has_static_send<Xt, std::void_t<decltype(std::declval<Xt&>().emc_static_send(std::declval<int&>(), std::declval<std::uint8_t*&>(), std::declval<std::size_t&>()))>>: std::true_type {};
+
+/* static_stage
+   base for stages that implement their message handling as non-virtual hooks, which a static_pipeline can resolve and
+   inline at compile time:
+    int  emc_static_recv(int& bus, std::uint8_t*& data, std::size_t& size) noexcept;
+    int  emc_static_send(int& bus, std::uint8_t*& data, std::size_t& size) noexcept;
+   the hooks may rewrite the message in place and return:
+    - err_okay, for the (possibly modified) message to continue along the pipeline;
+    - err_not_required, if the message was consumed;
+    - an error code, to abort processing.
+   The hooks must be accessible to the pipeline (i.e. public); the virtual emc_raw_recv()/emc_raw_send() are routed
+   through them as well, so the stage behaves the same when attached onto a regular reactor.
+*/
+template<typename Xt>
+class static_stage: public stage
+{
+  protected:
+  virtual int   emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept override {
+          int l_result = static_cast<Xt*>(this)->emc_static_recv(bus, data, size);
+          if(l_result == err_okay) {
+              return stage::emc_raw_recv(bus, data, size);
+          } else
+          if(l_result == err_not_required) {
+              return err_okay;
+          }
+          return l_result;
+  }
+
+  virtual int   emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept override {
+          int l_result = static_cast<Xt*>(this)->emc_static_send(bus, data, size);
+          if(l_result == err_okay) {
+              return stage::emc_raw_send(bus, data, size);
+          } else
+          if(l_result == err_not_required) {
+              return err_okay;
+          }
+          return l_result;
+  }
+
+  public:
+          static_stage(unsigned int type = stage_type_generic) noexcept:
+          stage(type) {
+  }
+
+          int   emc_static_recv(int&, std::uint8_t*&, std::size_t&) noexcept {
+          return err_okay;
+  }
+
+          int   emc_static_send(int&, std::uint8_t*&, std::size_t&) noexcept {
+          return err_okay;
+  }
+};
+
+/* static_pipeline
+   Reactor which owns a fixed list of stages, given at compile time;
+   - Rt is the reactor type to build upon (emc::reactor or one of the engines), Xs the stage types, in pipeline order;
+   - stages are attached, resumed, joined, dropped, suspended and detached exactly like on a regular reactor, the order
+     of the template arguments must thus agree with the order given by their stage_type_* (checked on resume());
+   - messages are passed from one stage to the next via their static hooks, which are resolved at compile time; a stage
+     without static hooks is invoked through its regular emc_raw_recv()/emc_raw_send() and forwards the message
+     dynamically from there on.
+*/
+template<typename Rt, typename... Xs>
+class static_pipeline: public Rt
+{
+  static_assert(std::is_base_of<reactor, Rt>::value, "static_pipeline must be built on top of a reactor");
+
+  using stage_list_t = std::tuple<Xs...>;
+
+  static constexpr std::size_t s_stage_count = sizeof...(Xs);
+
+  stage_list_t  m_stage_list;
+
+  private:
+  template<std::size_t... Ix>
+  inline  void  sys_attach_all(std::index_sequence<Ix...>) noexcept {
+          (this->pod_attach_stage(std::addressof(std::get<Ix>(m_stage_list))), ...);
+  }
+
+  template<std::size_t... Ix>
+  inline  void  sys_detach_all(std::index_sequence<Ix...>) noexcept {
+          (this->pod_detach_stage(std::addressof(std::get<s_stage_count - Ix - 1>(m_stage_list))), ...);
+  }
+
+  template<std::size_t... Ix>
+  inline  bool  sys_test_order(std::index_sequence<Ix...>) const noexcept {
+          const stage* l_stage_list[] = {std::addressof(std::get<Ix>(m_stage_list))...};
+          for(std::size_t i_stage = 1; i_stage < s_stage_count; i_stage++) {
+              if(l_stage_list[i_stage]->p_stage_prev != l_stage_list[i_stage - 1]) {
+                  return false;
+              }
+          }
+          return true;
+  }
+
+  template<std::size_t Ix>
+  inline  int   sys_recv(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          if constexpr (Ix == s_stage_count) {
+              int l_result = this->post(event::recv, event_info_t::for_recv(bus, data, size));
+              if(l_result == err_not_required) {
+                  l_result = err_okay;
+              }
+              return l_result;
+          } else
+          {
+              auto& l_stage = std::get<Ix>(m_stage_list);
+              if constexpr (has_static_recv<std::tuple_element_t<Ix, stage_list_t>>::value) {
+                  int l_result = l_stage.emc_static_recv(bus, data, size);
+                  if(l_result == err_okay) {
+                      return sys_recv<Ix + 1>(bus, data, size);
+                  } else
+                  if(l_result == err_not_required) {
+                      return err_okay;
+                  }
+                  return l_result;
+              } else
+                  return static_cast<stage&>(l_stage).emc_raw_recv(bus, data, size);
+          }
+  }
+
+  template<std::size_t Ix>
+  inline  int   sys_send(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          if constexpr (Ix == 0) {
+              int l_result = this->post(event::send, event_info_t::for_send(bus, data, size));
+              if(l_result == err_not_required) {
+                  l_result = err_okay;
+              }
+              return l_result;
+          } else
+          {
+              auto& l_stage = std::get<Ix - 1>(m_stage_list);
+              if constexpr (has_static_send<std::tuple_element_t<Ix - 1, stage_list_t>>::value) {
+                  int l_result = l_stage.emc_static_send(bus, data, size);
+                  if(l_result == err_okay) {
+                      return sys_send<Ix - 1>(bus, data, size);
+                  } else
+                  if(l_result == err_not_required) {
+                      return err_okay;
+                  }
+                  return l_result;
+              } else
+                  return static_cast<stage&>(l_stage).emc_raw_send(bus, data, size);
+          }
+  }
+
+  protected:
+  virtual int   emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept override {
+          return sys_recv<0>(bus, data, size);
+  }
+
+  virtual int   emc_raw_recv_batch(message_t* list, int count) noexcept override {
+          int         l_result = err_okay;
+          std::size_t l_mark = this->m_scratch_arena.get_mark();
+          for(int i_message = 0; i_message < count; i_message++) {
+              int l_recv_result = sys_recv<0>(list[i_message].bus, list[i_message].data, list[i_message].size);
+              this->m_scratch_arena.set_mark(l_mark);
+              if(l_recv_result != err_okay) {
+                  if(l_result == err_okay) {
+                      l_result = l_recv_result;
+                  }
+              }
+          }
+          return l_result;
+  }
+
+  public:
+  template<typename... Args>
+          static_pipeline(Args&&... args) noexcept:
+          Rt(std::forward<Args>(args)...),
+          m_stage_list() {
+          sys_attach_all(std::index_sequence_for<Xs...>());
+  }
+
+          static_pipeline(const static_pipeline&) noexcept = delete;
+          static_pipeline(static_pipeline&&) noexcept = delete;
+
+  virtual ~static_pipeline() {
+          sys_detach_all(std::index_sequence_for<Xs...>());
+  }
+
+  template<std::size_t Ix>
+  inline  auto& get_stage() noexcept {
+          return std::get<Ix>(m_stage_list);
+  }
+
+  /* resume()
+     start the pipeline; fails if the stages did not end up linked in the order of the template arguments
+  */
+          bool  resume() noexcept {
+          if(sys_test_order(std::index_sequence_for<Xs...>()) == false) {
+              return false;
+          }
+          return this->pod_resume();
+  }
+
+  /* recv()
+     feed a message into the pipeline, starting with the first stage; like the pod_recv*() functions, this opens a
+     dispatch, so the scratch memory the stages took is given back on return
+  */
+  inline  int   recv(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          int l_result;
+          this->sys_dispatch_enter();
+          l_result = sys_recv<0>(bus, data, size);
+          this->sys_dispatch_leave();
+          return l_result;
+  }
+
+  /* send()
+     return a message through the pipeline, starting with the last stage
+  */
+  inline  int   send(int bus, std::uint8_t* data, std::size_t size) noexcept {
+          int l_result;
+          this->sys_dispatch_enter();
+          l_result = sys_send<s_stage_count>(bus, data, size);
+          this->sys_dispatch_leave();
+          return l_result;
+  }
+
+          bool  suspend() noexcept {
+          return this->pod_suspend(false);
+  }
+
+          static_pipeline& operator=(const static_pipeline&) noexcept = delete;
+          static_pipeline& operator=(static_pipeline&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,113 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "stats.h"
+#include "error.h"
+
+namespace emc {
+
+      probe::probe() noexcept:
+      m_calls(0u),
+      m_bytes(0u),
+      m_errors(0u),
+      m_error_list{},
+      m_ticks(0u),
+      m_tick_list{}
+{
+}
+
+      probe::~probe()
+{
+}
+
+/* get_error_slot()
+   map an error code onto a slot of the error histogram: the low valued codes get a slot each, followed by err_refuse and
+   err_parse/err_not_required; slot 0 collects anything else
+*/
+int   probe::get_error_slot(int code) noexcept
+{
+      if((code < 0) &&
+          (code > -(probe_t::error_slot_count - 2))) {
+          return -code;
+      } else
+      if(code == err_refuse) {
+          return probe_t::error_slot_count - 2;
+      } else
+      if(code == err_not_required) {
+          return probe_t::error_slot_count - 1;
+      }
+      return 0;
+}
+
+/* get_error_code()
+   error code corresponding to a slot of the error histogram; returns err_okay for slot 0
+*/
+int   probe::get_error_code(int slot) noexcept
+{
+      if(slot == probe_t::error_slot_count - 1) {
+          return err_not_required;
+      } else
+      if(slot == probe_t::error_slot_count - 2) {
+          return err_refuse;
+      } else
+      if((slot > 0) &&
+          (slot < probe_t::error_slot_count - 2)) {
+          return -slot;
+      }
+      return err_okay;
+}
+
+/* get()
+   take a snapshot of the counters; safe to call from any thread, while the probe is being updated (the individual
+   counters are consistent, but may be off by the calls in flight relative to each other)
+*/
+void  probe::get(probe_t& stats) const noexcept
+{
+      stats.calls = m_calls.load(std::memory_order_relaxed);
+      stats.bytes = m_bytes.load(std::memory_order_relaxed);
+      stats.errors = m_errors.load(std::memory_order_relaxed);
+      for(int i_slot = 0; i_slot < probe_t::error_slot_count; i_slot++) {
+          stats.error_list[i_slot] = m_error_list[i_slot].load(std::memory_order_relaxed);
+      }
+      stats.ticks = m_ticks.load(std::memory_order_relaxed);
+      for(int i_slot = 0; i_slot < probe_t::tick_slot_count; i_slot++) {
+          stats.tick_list[i_slot] = m_tick_list[i_slot].load(std::memory_order_relaxed);
+      }
+}
+
+/* reset()
+   clear the counters; should only be called from the thread that updates the probe
+*/
+void  probe::reset() noexcept
+{
+      m_calls.store(0u, std::memory_order_relaxed);
+      m_bytes.store(0u, std::memory_order_relaxed);
+      m_errors.store(0u, std::memory_order_relaxed);
+      for(int i_slot = 0; i_slot < probe_t::error_slot_count; i_slot++) {
+          m_error_list[i_slot].store(0u, std::memory_order_relaxed);
+      }
+      m_ticks.store(0u, std::memory_order_relaxed);
+      for(int i_slot = 0; i_slot < probe_t::tick_slot_count; i_slot++) {
+          m_tick_list[i_slot].store(0u, std::memory_order_relaxed);
+      }
+}
+
+/*namespace emc*/ }
@@ -0,0 +1,142 @@
+#ifndef emc_stats_h
+#define emc_stats_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "emc.h"
+#include "error.h"
+#include "config.h"
+#include <atomic>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace emc {
+
+/* stats_enabled
+   whether the library was built with EMC_ENABLE_STATS; without it, the stage and reactor hooks compile down to plain
+   calls and the snapshot functions return empty results
+*/
+#ifdef EMC_ENABLE_STATS
+constexpr bool stats_enabled = true;
+#else
+constexpr bool stats_enabled = false;
+#endif
+
+/* probe_t
+   snapshot of the counters collected by a probe
+    - calls: number of messages handled;
+    - bytes: total payload size;
+    - errors: number of calls that returned anything other than err_okay, also broken down by error code in error_list
+      (see probe::get_error_code());
+    - ticks: total time spent in the calls, in cpu timestamp counter ticks, also broken down as a log2 histogram in
+      tick_list (slot `n` counts the calls that took [2^n, 2^(n+1)) ticks).
+*/
+struct probe_t
+{
+  static constexpr int error_slot_count = 16;
+  static constexpr int tick_slot_count = 32;
+
+  std::uint64_t calls;
+  std::uint64_t bytes;
+  std::uint64_t errors;
+  std::uint64_t error_list[error_slot_count];
+  std::uint64_t ticks;
+  std::uint64_t tick_list[tick_slot_count];
+};
+
+/* stage_stats_t
+   per stage snapshot; times are inclusive, i.e. they also cover the downstream stages the message was forwarded to
+*/
+struct stage_stats_t
+{
+  probe_t       recv;
+  probe_t       send;
+};
+
+/* probe
+   live counters for one direction of a stage; written from the reactor thread only, and readable from any thread via
+   get(), without locking
+*/
+class probe
+{
+  std::atomic<std::uint64_t>  m_calls;
+  std::atomic<std::uint64_t>  m_bytes;
+  std::atomic<std::uint64_t>  m_errors;
+  std::atomic<std::uint64_t>  m_error_list[probe_t::error_slot_count];
+  std::atomic<std::uint64_t>  m_ticks;
+  std::atomic<std::uint64_t>  m_tick_list[probe_t::tick_slot_count];
+
+  private:
+  /* emi_add()
+     single writer increment: avoids the locked read-modify-write of fetch_add()
+  */
+  static  inline void emi_add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+          counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  public:
+          probe() noexcept;
+          probe(const probe&) noexcept = delete;
+          probe(probe&&) noexcept = delete;
+          ~probe();
+
+  /* get_tick()
+     read the cpu timestamp counter (or a nanosecond clock on architectures without one)
+  */
+  static  inline std::uint64_t get_tick() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+          return __rdtsc();
+#else
+          struct timespec l_time;
+          clock_gettime(CLOCK_MONOTONIC, std::addressof(l_time));
+          return static_cast<std::uint64_t>(l_time.tv_sec) * 1000000000u + l_time.tv_nsec;
+#endif
+  }
+
+  static  int   get_error_slot(int) noexcept;
+  static  int   get_error_code(int) noexcept;
+
+  inline  void  record(std::uint64_t calls, std::uint64_t bytes, int result, std::uint64_t ticks) noexcept {
+          int l_tick_slot = 63 - __builtin_clzll(ticks | 1u);
+          if(l_tick_slot >= probe_t::tick_slot_count) {
+              l_tick_slot = probe_t::tick_slot_count - 1;
+          }
+          emi_add(m_calls, calls);
+          emi_add(m_bytes, bytes);
+          if(result != err_okay) {
+              emi_add(m_errors, 1u);
+              emi_add(m_error_list[get_error_slot(result)], 1u);
+          }
+          emi_add(m_ticks, ticks);
+          emi_add(m_tick_list[l_tick_slot], 1u);
+  }
+
+          void  get(probe_t&) const noexcept;
+          void  reset() noexcept;
+
+          probe& operator=(const probe&) noexcept = delete;
+          probe& operator=(probe&&) noexcept = delete;
+};
+
+/*namespace emc*/ }
+#endif
@@ -30,10 +30,158 @@ std::size_t  base16_encode(std::uint8_t* __restrict dst, const std::uint8_t* __r
 std::size_t  base16_encode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size) noexcept;
 std::size_t  base16_decode(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
 std::size_t  base16_decode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size) noexcept;
+std::size_t  base16_decode_checked(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size, std::size_t& offset) noexcept;
+std::size_t  base16_decode_checked(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size, std::size_t& offset) noexcept;
 std::size_t  base64_encode(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
 std::size_t  base64_encode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size) noexcept;
 std::size_t  base64_decode(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
 std::size_t  base64_decode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size) noexcept;
+std::size_t  cobs_get_encode_size(std::size_t size) noexcept;
+std::size_t  cobs_encode(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size, std::uint8_t delimiter = 0) noexcept;
+std::size_t  cobs_encode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size, std::uint8_t delimiter = 0) noexcept;
+std::size_t  cobs_decode(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size, std::size_t& offset, std::uint8_t delimiter = 0) noexcept;
+std::size_t  cobs_decode(std::uint8_t* __restrict dst, const char* __restrict src, std::size_t size, std::size_t& offset, std::uint8_t delimiter = 0) noexcept;
+
+/* base16_get_kernel_name(), base64_get_kernel_name(), cobs_get_kernel_name(), chacha20_get_kernel_name()
+   name of the vector kernel picked for this machine at load time, or "scalar"
+*/
+const char*  base16_get_kernel_name() noexcept;
+const char*  base64_get_kernel_name() noexcept;
+const char*  cobs_get_kernel_name() noexcept;
+const char*  chacha20_get_kernel_name() noexcept;
+
+/* lz_window_size, lz_hash_bits, lz_table_size
+   reach of the back references in a compressed block and size of the match finder state
+*/
+constexpr std::size_t lz_window_size = 4096;
+constexpr int         lz_hash_bits = 11;
+constexpr std::size_t lz_table_size = 1u << lz_hash_bits;
+
+std::size_t  lz_get_encode_size(std::size_t size) noexcept;
+std::size_t  lz_encode(std::uint8_t* __restrict dst, std::size_t dst_size, const std::uint8_t* __restrict src, std::size_t size, std::uint32_t* table) noexcept;
+std::size_t  lz_decode(std::uint8_t* __restrict dst, std::size_t dst_size, const std::uint8_t* __restrict src, std::size_t size, std::size_t& offset) noexcept;
+
+std::uint32_t crc32c(std::uint32_t crc, const std::uint8_t* src, std::size_t size) noexcept;
+std::uint32_t crc32c(std::uint32_t crc, const char* src, std::size_t size) noexcept;
+
+/* chacha20_key_size, chacha20_nonce_size
+*/
+constexpr std::size_t chacha20_key_size = 32;
+constexpr std::size_t chacha20_nonce_size = 12;
+
+void  chacha20_xor(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, const std::uint8_t* key, const std::uint8_t* nonce, std::uint32_t counter) noexcept;
+void  chacha20_block(std::uint8_t* dst, const std::uint8_t* key, const std::uint8_t* nonce, std::uint32_t counter) noexcept;
+void  poly1305_mac(std::uint8_t* tag, const std::uint8_t* src, std::size_t size, const std::uint8_t* key) noexcept;
+void  chacha20_poly1305_seal(std::uint8_t* tag, std::uint8_t* data, std::size_t size, const std::uint8_t* ad, std::size_t ad_size, const std::uint8_t* key, const std::uint8_t* nonce) noexcept;
+bool  chacha20_poly1305_open(const std::uint8_t* tag, std::uint8_t* data, std::size_t size, const std::uint8_t* ad, std::size_t ad_size, const std::uint8_t* key, const std::uint8_t* nonce) noexcept;
+
+/* base16_encoder
+   streaming counterpart of base16_encode(); stateless, provided for symmetry with the other codecs
+*/
+class base16_encoder
+{
+  public:
+          base16_encoder() noexcept;
+          ~base16_encoder();
+  static  std::size_t get_size_max(std::size_t) noexcept;
+          std::size_t update(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
+          std::size_t finish(std::uint8_t* dst) noexcept;
+          void        reset() noexcept;
+};
+
+/* base16_decoder
+   streaming, validating counterpart of base16_decode_checked(): a character left unpaired at the end of one update()
+   is carried over onto the next; decoding stops at the first character that is not a hex digit, or at finish() with an
+   unpaired character left over, after which has_error() is set and get_error_offset() gives the offset of the bad
+   character, counted from the start of the stream
+*/
+class base16_decoder
+{
+  std::size_t   m_offset;
+  std::size_t   m_error_offset;
+  std::uint8_t  m_carry;
+  bool          m_carry_bit;
+  bool          m_error_bit;
+
+  public:
+          base16_decoder() noexcept;
+          ~base16_decoder();
+  static  std::size_t get_size_max(std::size_t) noexcept;
+          std::size_t update(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
+          std::size_t finish(std::uint8_t* dst) noexcept;
+          bool        has_error() const noexcept;
+          std::size_t get_error_offset() const noexcept;
+          void        reset() noexcept;
+};
+
+/* base64_encoder
+   streaming counterpart of base64_encode(): up to 2 bytes of an incomplete group are carried over between calls to
+   update(), finish() encodes them along with the padding
+*/
+class base64_encoder
+{
+  std::uint8_t  m_carry[2];
+  int           m_carry_size;
+
+  public:
+          base64_encoder() noexcept;
+          ~base64_encoder();
+  static  std::size_t get_size_max(std::size_t) noexcept;
+          std::size_t update(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
+          std::size_t finish(std::uint8_t* dst) noexcept;
+          void        reset() noexcept;
+};
+
+/* base64_decoder
+   streaming counterpart of base64_decode(): up to 3 characters of an incomplete group are carried over between calls
+   to update(); a padded group ends the stream (anything after it is ignored), while finish() decodes a trailing group
+   left without padding
+*/
+class base64_decoder
+{
+  std::uint8_t  m_carry[4];
+  int           m_carry_size;
+  bool          m_final_bit;
+
+  private:
+          std::size_t emi_decode_group(std::uint8_t*, const std::uint8_t*) noexcept;
+
+  public:
+          base64_decoder() noexcept;
+          ~base64_decoder();
+  static  std::size_t get_size_max(std::size_t) noexcept;
+          std::size_t update(std::uint8_t* __restrict dst, const std::uint8_t* __restrict src, std::size_t size) noexcept;
+          std::size_t finish(std::uint8_t* dst) noexcept;
+          void        reset() noexcept;
+};
+
+/* poly1305
+   incremental RFC 8439 Poly1305 one time authenticator; input is buffered up to a whole block between calls to update()
+*/
+class poly1305
+{
+  std::uint64_t m_r[3];
+  std::uint64_t m_h[3];
+  std::uint64_t m_pad[2];
+  std::uint8_t  m_cache[16];
+  std::size_t   m_cache_size;
+
+  public:
+  static constexpr std::size_t key_size = 32;
+  static constexpr std::size_t tag_size = 16;
+  static constexpr std::size_t block_size = 16;
+
+  private:
+          void  emi_update(const std::uint8_t*, std::size_t, std::uint64_t) noexcept;
+
+  public:
+          poly1305() noexcept;
+          poly1305(const std::uint8_t*) noexcept;
+          ~poly1305();
+          void  reset(const std::uint8_t*) noexcept;
+          void  update(const std::uint8_t*, std::size_t) noexcept;
+          void  finish(std::uint8_t*) noexcept;
+};
 
 /*namespace transport*/ }
 /*namespace emc*/ }
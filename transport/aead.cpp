@@ -0,0 +1,97 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+/* aead_authenticate()
+   Poly1305 over the associated data and the cipher text, each padded to a whole block, followed by their lengths; the
+   one time key is the first block of key stream
+*/
+static void aead_authenticate(
+    std::uint8_t* tag,
+    const std::uint8_t* data, std::size_t size,
+    const std::uint8_t* ad, std::size_t ad_size,
+    const std::uint8_t* key, const std::uint8_t* nonce
+) noexcept {
+      static const std::uint8_t s_zero[poly1305::block_size] = {};
+      std::uint8_t  l_key[64];
+      std::uint8_t  l_size[16];
+      poly1305      l_mac;
+      chacha20_block(l_key, key, nonce, 0);
+      l_mac.reset(l_key);
+      l_mac.update(ad, ad_size);
+      l_mac.update(s_zero, (poly1305::block_size - ad_size % poly1305::block_size) % poly1305::block_size);
+      l_mac.update(data, size);
+      l_mac.update(s_zero, (poly1305::block_size - size % poly1305::block_size) % poly1305::block_size);
+      for(int i_byte = 0; i_byte < 8; i_byte++) {
+          l_size[i_byte] = static_cast<std::uint64_t>(ad_size) >> (i_byte * 8);
+          l_size[i_byte + 8] = static_cast<std::uint64_t>(size) >> (i_byte * 8);
+      }
+      l_mac.update(l_size, sizeof(l_size));
+      l_mac.finish(tag);
+      std::memset(l_key, 0, sizeof(l_key));
+}
+
+/* chacha20_poly1305_seal()
+   RFC 8439 AEAD construction: encrypt `size` bytes of `data` in place and write the tag authenticating them together
+   with `ad`
+*/
+void  chacha20_poly1305_seal(
+    std::uint8_t* tag,
+    std::uint8_t* data, std::size_t size,
+    const std::uint8_t* ad, std::size_t ad_size,
+    const std::uint8_t* key, const std::uint8_t* nonce
+) noexcept {
+      chacha20_xor(data, data, size, key, nonce, 1);
+      aead_authenticate(tag, data, size, ad, ad_size, key, nonce);
+}
+
+/* chacha20_poly1305_open()
+   verify `tag` against the cipher text and `ad`, and only if it matches decrypt `data` in place; returns false, with the
+   data left untouched, if it does not
+*/
+bool  chacha20_poly1305_open(
+    const std::uint8_t* tag,
+    std::uint8_t* data, std::size_t size,
+    const std::uint8_t* ad, std::size_t ad_size,
+    const std::uint8_t* key, const std::uint8_t* nonce
+) noexcept {
+      std::uint8_t l_tag[poly1305::tag_size];
+      std::uint8_t l_diff = 0;
+      aead_authenticate(l_tag, data, size, ad, ad_size, key, nonce);
+      // compare in constant time, so as not to tell how much of a forged tag was right
+      for(std::size_t i_byte = 0; i_byte < poly1305::tag_size; i_byte++) {
+          l_diff |= l_tag[i_byte] ^ tag[i_byte];
+      }
+      if(l_diff != 0) {
+          return false;
+      }
+      chacha20_xor(data, data, size, key, nonce, 1);
+      return true;
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -20,6 +20,11 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include <emc.h>
+#include <emc/transport.h>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 static const char s_base16_encode_map[256] = {
     '0', '1', '2', '3', '4', '5', '6', '7',  '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
@@ -40,7 +45,24 @@ static const char s_base16_decode_map[256] = {
 namespace emc {
 namespace transport {
 
-std::size_t base16_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+/* base16_get_value()
+   value of a hex digit, or -1 if the character is not one
+*/
+static inline int base16_get_value(std::uint8_t c) noexcept
+{
+      if((c >= '0') && (c <= '9')) {
+          return c - '0';
+      }
+      c |= 0x20;
+      if((c >= 'a') && (c <= 'f')) {
+          return c - 'a' + 10;
+      }
+      return -1;
+}
+
+/* base16_encode_scalar()
+*/
+static std::size_t base16_encode_scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
 {
       auto p_dst = dst;
       auto p_src = src;
@@ -56,12 +78,11 @@ std::size_t base16_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_
       return p_dst - dst;
 }
 
-std::size_t base16_encode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
-{
-      return base16_encode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
-}
-
-std::size_t base16_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+/* base16_decode_scalar()
+   lenient decoder: characters that are not hex digits decode as 0 and a dangling character at the end is decoded on its
+   own, as the low nibble of an extra byte
+*/
+static std::size_t base16_decode_scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
 {
       auto p_dst = dst;
       auto p_src = src;
@@ -79,10 +100,354 @@ std::size_t base16_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_
       return p_dst - dst;
 }
 
+#if defined(__x86_64__) || defined(__i386__)
+/* base16_encode_ssse3()
+   split every byte into its two nibbles, translate them with a single pshufb and interleave the results;
+   returns the number of input bytes consumed
+*/
+__attribute__((target("ssse3")))
+static std::size_t base16_encode_ssse3(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      __m128i     l_map = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_base16_encode_map));
+      __m128i     l_mask = _mm_set1_epi8(0x0f);
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          __m128i l_hi = _mm_shuffle_epi8(l_map, _mm_and_si128(_mm_srli_epi16(l_data, 4), l_mask));
+          __m128i l_lo = _mm_shuffle_epi8(l_map, _mm_and_si128(l_data, l_mask));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(l_hi, l_lo));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi8(l_hi, l_lo));
+          dst    += 32;
+          l_done += 16;
+      }
+      return l_done;
+}
+
+/* base16_decode_ssse3()
+   translate and validate 16 characters at a time: digits and (case folded) letters are range checked with unsigned
+   compares, anything else decodes as 0; pairs of nibbles are then merged with a multiply-add and packed;
+   in `check` mode, stops ahead of the first block holding an invalid character, for the scalar code to pinpoint it;
+   returns the number of input characters consumed
+*/
+__attribute__((target("ssse3")))
+static std::size_t base16_decode_ssse3(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, bool check) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          __m128i l_digit = _mm_sub_epi8(l_data, _mm_set1_epi8('0'));
+          __m128i l_alpha = _mm_sub_epi8(_mm_or_si128(l_data, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+          __m128i l_digit_mask = _mm_cmpeq_epi8(_mm_min_epu8(l_digit, _mm_set1_epi8(9)), l_digit);
+          __m128i l_alpha_mask = _mm_cmpeq_epi8(_mm_min_epu8(l_alpha, _mm_set1_epi8(5)), l_alpha);
+          __m128i l_value;
+          if(check) {
+              if(_mm_movemask_epi8(_mm_or_si128(l_digit_mask, l_alpha_mask)) != 0xffff) {
+                  break;
+              }
+          }
+          l_value = _mm_or_si128(
+              _mm_and_si128(l_digit_mask, l_digit),
+              _mm_and_si128(l_alpha_mask, _mm_add_epi8(l_alpha, _mm_set1_epi8(10)))
+          );
+          l_value = _mm_maddubs_epi16(l_value, _mm_set1_epi16(0x0110));
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(l_value, l_value));
+          dst    += 8;
+          l_done += 16;
+      }
+      return l_done;
+}
+
+/* base16_encode_avx2()
+*/
+__attribute__((target("avx2")))
+static std::size_t base16_encode_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      __m256i     l_map = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s_base16_encode_map)));
+      __m256i     l_mask = _mm256_set1_epi8(0x0f);
+      while(size - l_done >= 32) {
+          __m256i l_data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          __m256i l_hi = _mm256_shuffle_epi8(l_map, _mm256_and_si256(_mm256_srli_epi16(l_data, 4), l_mask));
+          __m256i l_lo = _mm256_shuffle_epi8(l_map, _mm256_and_si256(l_data, l_mask));
+          __m256i l_first = _mm256_unpacklo_epi8(l_hi, l_lo);
+          __m256i l_second = _mm256_unpackhi_epi8(l_hi, l_lo);
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(l_first, l_second, 0x20));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), _mm256_permute2x128_si256(l_first, l_second, 0x31));
+          dst    += 64;
+          l_done += 32;
+      }
+      _mm256_zeroupper();
+      return l_done + base16_encode_ssse3(dst, src + l_done, size - l_done);
+}
+
+/* base16_decode_avx2()
+*/
+__attribute__((target("avx2")))
+static std::size_t base16_decode_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, bool check) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 32) {
+          __m256i l_data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          __m256i l_digit = _mm256_sub_epi8(l_data, _mm256_set1_epi8('0'));
+          __m256i l_alpha = _mm256_sub_epi8(_mm256_or_si256(l_data, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+          __m256i l_digit_mask = _mm256_cmpeq_epi8(_mm256_min_epu8(l_digit, _mm256_set1_epi8(9)), l_digit);
+          __m256i l_alpha_mask = _mm256_cmpeq_epi8(_mm256_min_epu8(l_alpha, _mm256_set1_epi8(5)), l_alpha);
+          __m256i l_value;
+          if(check) {
+              if(_mm256_movemask_epi8(_mm256_or_si256(l_digit_mask, l_alpha_mask)) != -1) {
+                  break;
+              }
+          }
+          l_value = _mm256_or_si256(
+              _mm256_and_si256(l_digit_mask, l_digit),
+              _mm256_and_si256(l_alpha_mask, _mm256_add_epi8(l_alpha, _mm256_set1_epi8(10)))
+          );
+          l_value = _mm256_maddubs_epi16(l_value, _mm256_set1_epi16(0x0110));
+          l_value = _mm256_permute4x64_epi64(_mm256_packus_epi16(l_value, l_value), 0b1000);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(l_value));
+          dst    += 16;
+          l_done += 32;
+      }
+      _mm256_zeroupper();
+      return l_done + base16_decode_ssse3(dst, src + l_done, size - l_done, check);
+}
+#endif
+
+/* base16_kernel_t
+   vector kernels picked once, at load time, from the features reported by cpuid
+*/
+struct base16_kernel_t
+{
+  std::size_t (*encode)(std::uint8_t*, const std::uint8_t*, std::size_t) noexcept;
+  std::size_t (*decode)(std::uint8_t*, const std::uint8_t*, std::size_t, bool) noexcept;
+  const char*   name;
+};
+
+static std::size_t base16_encode_none(std::uint8_t*, const std::uint8_t*, std::size_t) noexcept
+{
+      return 0;
+}
+
+static std::size_t base16_decode_none(std::uint8_t*, const std::uint8_t*, std::size_t, bool) noexcept
+{
+      return 0;
+}
+
+/* base16_get_kernel()
+   pick the widest kernel the cpu supports; setting EMC_NO_SIMD in the environment forces the scalar implementation, so
+   that both can be measured on the same machine
+*/
+static base16_kernel_t base16_get_kernel() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+      if(std::getenv("EMC_NO_SIMD") == nullptr) {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx2")) {
+              return {base16_encode_avx2, base16_decode_avx2, "avx2"};
+          }
+          if(__builtin_cpu_supports("ssse3")) {
+              return {base16_encode_ssse3, base16_decode_ssse3, "ssse3"};
+          }
+      }
+#endif
+      return {base16_encode_none, base16_decode_none, "scalar"};
+}
+
+static const base16_kernel_t s_base16_kernel = base16_get_kernel();
+
+const char* base16_get_kernel_name() noexcept
+{
+      return s_base16_kernel.name;
+}
+
+std::size_t base16_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = s_base16_kernel.encode(dst, src, size);
+      return l_done * 2 + base16_encode_scalar(dst + l_done * 2, src + l_done, size - l_done);
+}
+
+std::size_t base16_encode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
+{
+      return base16_encode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
+}
+
+std::size_t base16_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = s_base16_kernel.decode(dst, src, size, false);
+      return l_done / 2 + base16_decode_scalar(dst + l_done / 2, src + l_done, size - l_done);
+}
+
 std::size_t base16_decode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
 {
       return base16_decode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
 }
 
+/* base16_decode_checked()
+   validating decoder: decodes up to the first character that is not a hex digit and stores its position in `offset`;
+   an odd length input is malformed as well, in which case `offset` points to the last, unpaired character;
+   `offset` is set to `size` if the whole input was valid;
+   returns the number of bytes written to `dst`
+*/
+std::size_t base16_decode_checked(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::size_t& offset) noexcept
+{
+      std::size_t l_done = s_base16_kernel.decode(dst, src, size, true);
+      std::size_t l_tail = size & (~static_cast<std::size_t>(1));
+      auto        p_dst = dst + l_done / 2;
+      while(l_done < l_tail) {
+          int l_hi = base16_get_value(src[l_done]);
+          int l_lo = base16_get_value(src[l_done + 1]);
+          if(l_hi < 0) {
+              offset = l_done;
+              return p_dst - dst;
+          }
+          if(l_lo < 0) {
+              offset = l_done + 1;
+              return p_dst - dst;
+          }
+          *(p_dst++) = (l_hi << 4) | l_lo;
+          l_done += 2;
+      }
+      if(l_done < size) {
+          offset = l_done;
+          return p_dst - dst;
+      }
+      offset = size;
+      return p_dst - dst;
+}
+
+std::size_t base16_decode_checked(std::uint8_t* dst, const char* src, std::size_t size, std::size_t& offset) noexcept
+{
+      return base16_decode_checked(dst, reinterpret_cast<const std::uint8_t*>(src), size, offset);
+}
+
+      base16_encoder::base16_encoder() noexcept
+{
+}
+
+      base16_encoder::~base16_encoder()
+{
+}
+
+/* get_size_max()
+   upper bound of the output produced by update() and finish() for `size` bytes of input
+*/
+std::size_t base16_encoder::get_size_max(std::size_t size) noexcept
+{
+      return size * 2;
+}
+
+std::size_t base16_encoder::update(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      return base16_encode(dst, src, size);
+}
+
+std::size_t base16_encoder::finish(std::uint8_t*) noexcept
+{
+      return 0;
+}
+
+void  base16_encoder::reset() noexcept
+{
+}
+
+      base16_decoder::base16_decoder() noexcept:
+      m_offset(0),
+      m_error_offset(0),
+      m_carry(0),
+      m_carry_bit(false),
+      m_error_bit(false)
+{
+}
+
+      base16_decoder::~base16_decoder()
+{
+}
+
+std::size_t base16_decoder::get_size_max(std::size_t size) noexcept
+{
+      return (size + 1) / 2;
+}
+
+/* update()
+   decode the next `size` characters of the stream; returns the number of bytes written to `dst`, which is 0 once an
+   invalid character has been met
+*/
+std::size_t base16_decoder::update(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      std::size_t   l_offset;
+      if(m_error_bit) {
+          return 0;
+      }
+      if(m_carry_bit) {
+          if(size == 0) {
+              return 0;
+          }
+          int l_hi = base16_get_value(m_carry);
+          int l_lo = base16_get_value(src[0]);
+          if(l_lo < 0) {
+              m_error_offset = m_offset;
+              m_error_bit = true;
+              return 0;
+          }
+          *(p_dst++) = (l_hi << 4) | l_lo;
+          m_carry_bit = false;
+          m_offset++;
+          src++;
+          size--;
+      }
+      p_dst += base16_decode_checked(p_dst, src, size & (~static_cast<std::size_t>(1)), l_offset);
+      if(l_offset < (size & (~static_cast<std::size_t>(1)))) {
+          m_error_offset = m_offset + l_offset;
+          m_error_bit = true;
+          return p_dst - dst;
+      }
+      if(size & 1) {
+          if(base16_get_value(src[size - 1]) < 0) {
+              m_error_offset = m_offset + size - 1;
+              m_error_bit = true;
+              return p_dst - dst;
+          }
+          m_carry = src[size - 1];
+          m_carry_bit = true;
+      }
+      m_offset += size;
+      return p_dst - dst;
+}
+
+/* finish()
+   end of stream: a character still waiting for its pair is an error
+*/
+std::size_t base16_decoder::finish(std::uint8_t*) noexcept
+{
+      if(m_carry_bit) {
+          if(m_error_bit == false) {
+              m_error_offset = m_offset - 1;
+              m_error_bit = true;
+          }
+          m_carry_bit = false;
+      }
+      return 0;
+}
+
+bool  base16_decoder::has_error() const noexcept
+{
+      return m_error_bit;
+}
+
+std::size_t base16_decoder::get_error_offset() const noexcept
+{
+      return m_error_offset;
+}
+
+void  base16_decoder::reset() noexcept
+{
+      m_offset = 0;
+      m_error_offset = 0;
+      m_carry = 0;
+      m_carry_bit = false;
+      m_error_bit = false;
+}
+
 /*namespace transport*/ }
-/*namespace emc*/ }
\ No newline at end of file
+/*namespace emc*/ }
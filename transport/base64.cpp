@@ -20,8 +20,15 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include <emc.h>
+#include <emc/transport.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
-static const char s_base64_encode_map[64] = {
+static constexpr char s_base64_encode_map[64] = {
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',  'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
     'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',  'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
     'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',  'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
@@ -53,7 +60,10 @@ static const char s_base64_decode_map[256] = {
 namespace emc {
 namespace transport {
 
-std::size_t base64_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+/* base64_encode_scalar()
+   reference implementation, also used for the input the vector kernels leave over
+*/
+static std::size_t base64_encode_scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
 {
       unsigned int  i_cvt;
       std::uint8_t* p_dst = dst;
@@ -87,12 +97,10 @@ std::size_t base64_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_
       return p_dst - dst;
 }
 
-std::size_t base64_encode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
-{
-      return base64_encode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
-}
-
-std::size_t base64_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+/* base64_decode_scalar()
+   reference implementation, also used for the input the vector kernels leave over
+*/
+static std::size_t base64_decode_scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
 {
       unsigned int  i_cvt;
       std::uint8_t* p_dst = dst;
@@ -130,10 +138,519 @@ std::size_t base64_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_
       return p_dst - dst;
 }
 
+#if defined(__x86_64__) || defined(__i386__)
+/* base64_encode_sse41()
+   Muła's pshufb based encoder: 12 input bytes are spread onto 16 lanes, the 6 bit indices are extracted with a pair of
+   multiplies and translated into characters via a 16 entry offset table;
+   returns the number of input bytes consumed.
+*/
+__attribute__((target("ssse3,sse4.1")))
+static inline __m128i base64_encode_sse41_block(__m128i in) noexcept
+{
+      in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+      __m128i l_t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+      __m128i l_t1 = _mm_mulhi_epu16(l_t0, _mm_set1_epi32(0x04000040));
+      __m128i l_t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+      __m128i l_t3 = _mm_mullo_epi16(l_t2, _mm_set1_epi32(0x01000010));
+      __m128i l_index = _mm_or_si128(l_t1, l_t3);
+      __m128i l_shift = _mm_subs_epu8(l_index, _mm_set1_epi8(51));
+      __m128i l_lower = _mm_cmpgt_epi8(_mm_set1_epi8(26), l_index);
+      l_shift = _mm_or_si128(l_shift, _mm_and_si128(l_lower, _mm_set1_epi8(13)));
+      l_shift = _mm_shuffle_epi8(
+          _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0),
+          l_shift
+      );
+      return _mm_add_epi8(l_shift, l_index);
+}
+
+__attribute__((target("ssse3,sse4.1")))
+static std::size_t base64_encode_sse41(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), base64_encode_sse41_block(l_data));
+          dst    += 16;
+          l_done += 12;
+      }
+      return l_done;
+}
+
+/* base64_decode_sse41()
+   validating translation by nibble lookup tables; characters outside of the base64 alphabet decode as 0, same as the
+   scalar implementation does; 4 characters are then merged into 3 bytes with two multiply-add steps
+*/
+__attribute__((target("ssse3,sse4.1")))
+static inline __m128i base64_decode_sse41_block(__m128i in) noexcept
+{
+      __m128i l_hi_nibble = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+      __m128i l_lo_nibble = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+      __m128i l_shift = _mm_shuffle_epi8(_mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), l_hi_nibble);
+      __m128i l_slash = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2f));
+      __m128i l_mask = _mm_shuffle_epi8(
+          _mm_setr_epi8(
+              static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+              static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+              static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54,
+              0x50, 0x50, 0x50, 0x54
+          ),
+          l_lo_nibble
+      );
+      __m128i l_bit = _mm_shuffle_epi8(
+          _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0),
+          l_hi_nibble
+      );
+      __m128i l_invalid = _mm_cmpeq_epi8(_mm_and_si128(l_mask, l_bit), _mm_setzero_si128());
+      __m128i l_value;
+      l_shift = _mm_blendv_epi8(l_shift, _mm_set1_epi8(16), l_slash);
+      l_value = _mm_andnot_si128(l_invalid, _mm_add_epi8(in, l_shift));
+      l_value = _mm_maddubs_epi16(l_value, _mm_set1_epi32(0x01400140));
+      l_value = _mm_madd_epi16(l_value, _mm_set1_epi32(0x00011000));
+      return _mm_shuffle_epi8(l_value, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3,sse4.1")))
+static inline void base64_decode_sse41_store(std::uint8_t* dst, __m128i value) noexcept
+{
+      std::uint32_t l_tail = _mm_extract_epi32(value, 2);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+      std::memcpy(dst + 8, std::addressof(l_tail), sizeof(l_tail));
+}
+
+__attribute__((target("ssse3,sse4.1")))
+static std::size_t base64_decode_sse41(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          base64_decode_sse41_store(dst, base64_decode_sse41_block(l_data));
+          dst    += 12;
+          l_done += 16;
+      }
+      return l_done;
+}
+
+/* base64_encode_avx2()
+   same algorithm as the SSE4.1 kernel, on two 12 byte groups at a time
+*/
+__attribute__((target("avx2")))
+static std::size_t base64_encode_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 28) {
+          __m256i l_data = _mm256_inserti128_si256(
+              _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done))),
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done + 12)),
+              1
+          );
+          l_data = _mm256_shuffle_epi8(l_data, _mm256_setr_epi8(
+              1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+              1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+          ));
+          __m256i l_t0 = _mm256_and_si256(l_data, _mm256_set1_epi32(0x0fc0fc00));
+          __m256i l_t1 = _mm256_mulhi_epu16(l_t0, _mm256_set1_epi32(0x04000040));
+          __m256i l_t2 = _mm256_and_si256(l_data, _mm256_set1_epi32(0x003f03f0));
+          __m256i l_t3 = _mm256_mullo_epi16(l_t2, _mm256_set1_epi32(0x01000010));
+          __m256i l_index = _mm256_or_si256(l_t1, l_t3);
+          __m256i l_shift = _mm256_subs_epu8(l_index, _mm256_set1_epi8(51));
+          __m256i l_lower = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), l_index);
+          l_shift = _mm256_or_si256(l_shift, _mm256_and_si256(l_lower, _mm256_set1_epi8(13)));
+          l_shift = _mm256_shuffle_epi8(
+              _mm256_setr_epi8(
+                  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                  '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                  '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+              ),
+              l_shift
+          );
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_add_epi8(l_shift, l_index));
+          dst    += 32;
+          l_done += 24;
+      }
+      // the SSE4.1 kernel is legacy encoded: clear the upper halves first, or each switch costs a state transition
+      _mm256_zeroupper();
+      return l_done + base64_encode_sse41(dst, src + l_done, size - l_done);
+}
+
+/* base64_decode_avx2()
+*/
+__attribute__((target("avx2")))
+static std::size_t base64_decode_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      while(size - l_done >= 32) {
+          __m256i l_data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          __m256i l_hi_nibble = _mm256_and_si256(_mm256_srli_epi32(l_data, 4), _mm256_set1_epi8(0x0f));
+          __m256i l_lo_nibble = _mm256_and_si256(l_data, _mm256_set1_epi8(0x0f));
+          __m256i l_shift = _mm256_shuffle_epi8(
+              _mm256_setr_epi8(
+                  0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                  0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+              ),
+              l_hi_nibble
+          );
+          __m256i l_slash = _mm256_cmpeq_epi8(l_data, _mm256_set1_epi8(0x2f));
+          __m256i l_mask = _mm256_shuffle_epi8(
+              _mm256_setr_epi8(
+                  static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                  static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                  static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54,
+                  0x50, 0x50, 0x50, 0x54,
+                  static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                  static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                  static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54,
+                  0x50, 0x50, 0x50, 0x54
+              ),
+              l_lo_nibble
+          );
+          __m256i l_bit = _mm256_shuffle_epi8(
+              _mm256_setr_epi8(
+                  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0,
+                  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0
+              ),
+              l_hi_nibble
+          );
+          __m256i l_invalid = _mm256_cmpeq_epi8(_mm256_and_si256(l_mask, l_bit), _mm256_setzero_si256());
+          __m256i l_value;
+          l_shift = _mm256_blendv_epi8(l_shift, _mm256_set1_epi8(16), l_slash);
+          l_value = _mm256_andnot_si256(l_invalid, _mm256_add_epi8(l_data, l_shift));
+          l_value = _mm256_maddubs_epi16(l_value, _mm256_set1_epi32(0x01400140));
+          l_value = _mm256_madd_epi16(l_value, _mm256_set1_epi32(0x00011000));
+          l_value = _mm256_shuffle_epi8(l_value, _mm256_setr_epi8(
+              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+          ));
+          base64_decode_sse41_store(dst, _mm256_castsi256_si128(l_value));
+          base64_decode_sse41_store(dst + 12, _mm256_extracti128_si256(l_value, 1));
+          dst    += 24;
+          l_done += 32;
+      }
+      _mm256_zeroupper();
+      return l_done + base64_decode_sse41(dst, src + l_done, size - l_done);
+}
+
+/* base64_vbmi_map_t
+   128 entry translation table for the AVX-512 VBMI decoder: 6 bit value for the base64 alphabet, 0x80 for anything else
+*/
+struct base64_vbmi_map_t
+{
+  std::uint8_t  value_list[128];
+
+  constexpr base64_vbmi_map_t() noexcept:
+      value_list() {
+      for(int i_char = 0; i_char < 128; i_char++) {
+          value_list[i_char] = 0x80;
+      }
+      for(int i_value = 0; i_value < 64; i_value++) {
+          value_list[static_cast<int>(s_base64_encode_map[i_value])] = i_value;
+      }
+  }
+};
+
+/* base64_encode_vbmi()
+   48 input bytes at a time: one byte permute spreads them into 16 dwords, vpmultishiftqb extracts the 6 bit indices
+   and a second permute translates them through the 64 character alphabet
+*/
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+static std::size_t base64_encode_vbmi(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = 0;
+      __m512i     l_alphabet = _mm512_loadu_si512(s_base64_encode_map);
+      __m512i     l_spread = _mm512_setr_epi32(
+          0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d, 0x10110f10, 0x13141213, 0x16171516,
+          0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122, 0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e
+      );
+      __m512i     l_shift = _mm512_set1_epi64(0x3036242a1016040a);
+      __mmask64   l_full = ~0ull;
+      while(size - l_done >= 48) {
+          __m512i l_data = _mm512_maskz_loadu_epi8(0x0000ffffffffffffull, src + l_done);
+          l_data = _mm512_maskz_permutexvar_epi8(l_full, l_spread, l_data);
+          l_data = _mm512_maskz_multishift_epi64_epi8(l_full, l_shift, l_data);
+          _mm512_storeu_si512(dst, _mm512_maskz_permutexvar_epi8(l_full, l_data, l_alphabet));
+          dst    += 64;
+          l_done += 48;
+      }
+      return l_done + base64_encode_avx2(dst, src + l_done, size - l_done);
+}
+
+/* base64_decode_vbmi()
+   64 characters at a time, translated with a two table byte permute; the top bit of either the input or the
+   translated value flags characters outside of the alphabet, which decode as 0
+*/
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+static std::size_t base64_decode_vbmi(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      static constexpr base64_vbmi_map_t s_map;
+      std::size_t l_done = 0;
+      __m512i     l_map_lo = _mm512_loadu_si512(s_map.value_list);
+      __m512i     l_map_hi = _mm512_loadu_si512(s_map.value_list + 64);
+      __m512i     l_pack = _mm512_setr_epi32(
+          0x06000102, 0x090a0405, 0x0c0d0e08, 0x16101112, 0x191a1415, 0x1c1d1e18, 0x26202122, 0x292a2425,
+          0x2c2d2e28, 0x36303132, 0x393a3435, 0x3c3d3e38, 0x00000000, 0x00000000, 0x00000000, 0x00000000
+      );
+      __mmask64   l_full = ~0ull;
+      while(size - l_done >= 64) {
+          __m512i   l_data = _mm512_loadu_si512(src + l_done);
+          __m512i   l_value = _mm512_maskz_permutex2var_epi8(l_full, l_map_lo, l_data, l_map_hi);
+          __mmask64 l_invalid = _mm512_movepi8_mask(_mm512_or_si512(l_value, l_data));
+          l_value = _mm512_maskz_mov_epi8(~l_invalid, l_value);
+          l_value = _mm512_maddubs_epi16(l_value, _mm512_set1_epi32(0x01400140));
+          l_value = _mm512_madd_epi16(l_value, _mm512_set1_epi32(0x00011000));
+          l_value = _mm512_maskz_permutexvar_epi8(l_full, l_pack, l_value);
+          _mm512_mask_storeu_epi8(dst, 0x0000ffffffffffffull, l_value);
+          dst    += 48;
+          l_done += 64;
+      }
+      return l_done + base64_decode_avx2(dst, src + l_done, size - l_done);
+}
+#endif
+
+/* base64_kernel_t
+   vector kernels picked once, at load time, from the features reported by cpuid; each returns the number of input bytes
+   it processed, the remainder going through the scalar implementation
+*/
+struct base64_kernel_t
+{
+  std::size_t (*encode)(std::uint8_t*, const std::uint8_t*, std::size_t) noexcept;
+  std::size_t (*decode)(std::uint8_t*, const std::uint8_t*, std::size_t) noexcept;
+  const char*   name;
+};
+
+static std::size_t base64_none(std::uint8_t*, const std::uint8_t*, std::size_t) noexcept
+{
+      return 0;
+}
+
+/* base64_get_kernel()
+   pick the widest kernel the cpu supports; setting EMC_NO_SIMD in the environment forces the scalar implementation, so
+   that both can be measured on the same machine
+*/
+static base64_kernel_t base64_get_kernel() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+      if(std::getenv("EMC_NO_SIMD") == nullptr) {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx512vbmi") &&
+              __builtin_cpu_supports("avx512bw")) {
+              return {base64_encode_vbmi, base64_decode_vbmi, "avx512vbmi"};
+          }
+          if(__builtin_cpu_supports("avx2")) {
+              return {base64_encode_avx2, base64_decode_avx2, "avx2"};
+          }
+          if(__builtin_cpu_supports("sse4.1")) {
+              return {base64_encode_sse41, base64_decode_sse41, "sse4.1"};
+          }
+      }
+#endif
+      return {base64_none, base64_none, "scalar"};
+}
+
+static const base64_kernel_t s_base64_kernel = base64_get_kernel();
+
+const char* base64_get_kernel_name() noexcept
+{
+      return s_base64_kernel.name;
+}
+
+std::size_t base64_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = s_base64_kernel.encode(dst, src, size);
+      std::size_t l_size = l_done / 3 * 4;
+      return l_size + base64_encode_scalar(dst + l_size, src + l_done, size - l_done);
+}
+
+std::size_t base64_encode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
+{
+      return base64_encode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
+}
+
+std::size_t base64_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::size_t l_done = s_base64_kernel.decode(dst, src, size);
+      std::size_t l_size = l_done / 4 * 3;
+      return l_size + base64_decode_scalar(dst + l_size, src + l_done, size - l_done);
+}
+
 std::size_t base64_decode(std::uint8_t* dst, const char* src, std::size_t size) noexcept
 {
       return base64_decode(dst, reinterpret_cast<const std::uint8_t*>(src), size);
 }
 
+      base64_encoder::base64_encoder() noexcept:
+      m_carry_size(0)
+{
+}
+
+      base64_encoder::~base64_encoder()
+{
+}
+
+/* get_size_max()
+   upper bound of the output produced by update() and finish() for `size` bytes of input, including whatever is carried
+   over from a previous call
+*/
+std::size_t base64_encoder::get_size_max(std::size_t size) noexcept
+{
+      return (size + 2 + 2) / 3 * 4;
+}
+
+/* update()
+   encode the next `size` bytes of the stream; only complete groups of 3 bytes are encoded, the remainder is kept until
+   the next call; returns the number of characters written to `dst`
+*/
+std::size_t base64_encoder::update(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      if(m_carry_size) {
+          std::uint8_t l_group[3];
+          if(m_carry_size + size < 3) {
+              while(size) {
+                  m_carry[m_carry_size++] = *(src++);
+                  size--;
+              }
+              return 0;
+          }
+          std::memcpy(l_group, m_carry, m_carry_size);
+          std::memcpy(l_group + m_carry_size, src, 3 - m_carry_size);
+          src += 3 - m_carry_size;
+          size -= 3 - m_carry_size;
+          p_dst += base64_encode(p_dst, l_group, 3);
+          m_carry_size = 0;
+      }
+      std::size_t l_rem_size = size % 3;
+      std::size_t l_cpt_size = size - l_rem_size;
+      p_dst += base64_encode(p_dst, src, l_cpt_size);
+      std::memcpy(m_carry, src + l_cpt_size, l_rem_size);
+      m_carry_size = l_rem_size;
+      return p_dst - dst;
+}
+
+/* finish()
+   encode the bytes carried over, padded to a complete group
+*/
+std::size_t base64_encoder::finish(std::uint8_t* dst) noexcept
+{
+      std::size_t l_size = base64_encode(dst, m_carry, m_carry_size);
+      m_carry_size = 0;
+      return l_size;
+}
+
+void  base64_encoder::reset() noexcept
+{
+      m_carry_size = 0;
+}
+
+      base64_decoder::base64_decoder() noexcept:
+      m_carry_size(0),
+      m_final_bit(false)
+{
+}
+
+      base64_decoder::~base64_decoder()
+{
+}
+
+/* emi_decode_group()
+   decode a single group of 4 characters, honouring the padding; a padded group ends the stream
+*/
+std::size_t base64_decoder::emi_decode_group(std::uint8_t* dst, const std::uint8_t* src) noexcept
+{
+      unsigned int i_cvt;
+      if((src[0] == '=') || (src[1] == '=')) {
+          m_final_bit = true;
+          return 0;
+      }
+      i_cvt = s_base64_decode_map[src[0]] << 18;
+      i_cvt |= s_base64_decode_map[src[1]] << 12;
+      i_cvt |= s_base64_decode_map[src[2]] << 6;
+      i_cvt |= s_base64_decode_map[src[3]];
+      dst[0] = (i_cvt & 0xff0000) >> 16;
+      if(src[2] == '=') {
+          m_final_bit = true;
+          return 1;
+      }
+      dst[1] = (i_cvt & 0x00ff00) >> 8;
+      if(src[3] == '=') {
+          m_final_bit = true;
+          return 2;
+      }
+      dst[2] = (i_cvt & 0x0000ff);
+      return 3;
+}
+
+std::size_t base64_decoder::get_size_max(std::size_t size) noexcept
+{
+      return (size + 3 + 3) / 4 * 3;
+}
+
+/* update()
+   decode the next `size` characters of the stream; only complete groups of 4 characters are decoded, the remainder is
+   kept until the next call; returns the number of bytes written to `dst`
+*/
+std::size_t base64_decoder::update(std::uint8_t* dst, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      if(m_final_bit) {
+          return 0;
+      }
+      if(m_carry_size) {
+          while(size && (m_carry_size < 4)) {
+              m_carry[m_carry_size++] = *(src++);
+              size--;
+          }
+          if(m_carry_size < 4) {
+              return 0;
+          }
+          p_dst += emi_decode_group(p_dst, m_carry);
+          m_carry_size = 0;
+          if(m_final_bit) {
+              return p_dst - dst;
+          }
+      }
+      std::size_t l_rem_size = size % 4;
+      std::size_t l_cpt_size = size - l_rem_size;
+      if(l_cpt_size) {
+          // the vector kernels know nothing about padding, so find the group that ends the stream ahead of them
+          auto p_pad = reinterpret_cast<const std::uint8_t*>(std::memchr(src, '=', l_cpt_size));
+          if(p_pad != nullptr) {
+              l_cpt_size = (p_pad - src) & (~static_cast<std::size_t>(3));
+              p_dst += base64_decode(p_dst, src, l_cpt_size);
+              p_dst += emi_decode_group(p_dst, src + l_cpt_size);
+              m_final_bit = true;
+              return p_dst - dst;
+          }
+          p_dst += base64_decode(p_dst, src, l_cpt_size);
+      }
+      std::memcpy(m_carry, src + l_cpt_size, l_rem_size);
+      m_carry_size = l_rem_size;
+      return p_dst - dst;
+}
+
+/* finish()
+   decode the characters of a trailing group left without padding; a single character does not make a byte and is
+   dropped
+*/
+std::size_t base64_decoder::finish(std::uint8_t* dst) noexcept
+{
+      std::size_t l_size = 0;
+      if(m_carry_size > 1) {
+          m_carry[m_carry_size] = '=';
+          if(m_carry_size < 3) {
+              m_carry[3] = '=';
+          }
+          l_size = emi_decode_group(dst, m_carry);
+      }
+      m_carry_size = 0;
+      return l_size;
+}
+
+void  base64_decoder::reset() noexcept
+{
+      m_carry_size = 0;
+      m_final_bit = false;
+}
+
 /*namespace transport*/ }
 /*namespace emc*/ }
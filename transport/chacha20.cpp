@@ -0,0 +1,340 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace emc {
+namespace transport {
+
+/* chacha20_block_size
+*/
+static constexpr std::size_t chacha20_block_size = 64;
+
+static inline std::uint32_t chacha20_load(const std::uint8_t* src) noexcept
+{
+      return src[0] | (src[1] << 8) | (src[2] << 16) | (static_cast<std::uint32_t>(src[3]) << 24);
+}
+
+static inline std::uint32_t chacha20_rotl(std::uint32_t value, int bits) noexcept
+{
+      return (value << bits) | (value >> (32 - bits));
+}
+
+/* chacha20_quarter()
+*/
+static inline void chacha20_quarter(std::uint32_t& a, std::uint32_t& b, std::uint32_t& c, std::uint32_t& d) noexcept
+{
+      a += b; d = chacha20_rotl(d ^ a, 16);
+      c += d; b = chacha20_rotl(b ^ c, 12);
+      a += b; d = chacha20_rotl(d ^ a, 8);
+      c += d; b = chacha20_rotl(b ^ c, 7);
+}
+
+/* chacha20_init()
+   initial state: the constant "expand 32-byte k", the key, the block counter and the nonce
+*/
+static void chacha20_init(std::uint32_t* state, const std::uint8_t* key, const std::uint8_t* nonce, std::uint32_t counter) noexcept
+{
+      state[0] = 0x61707865u;
+      state[1] = 0x3320646eu;
+      state[2] = 0x79622d32u;
+      state[3] = 0x6b206574u;
+      for(int i_word = 0; i_word < 8; i_word++) {
+          state[4 + i_word] = chacha20_load(key + i_word * 4);
+      }
+      state[12] = counter;
+      state[13] = chacha20_load(nonce);
+      state[14] = chacha20_load(nonce + 4);
+      state[15] = chacha20_load(nonce + 8);
+}
+
+/* chacha20_block_scalar()
+   reference implementation: produce a single block of key stream and advance the counter
+*/
+static void chacha20_block_scalar(std::uint8_t* dst, std::uint32_t* state) noexcept
+{
+      std::uint32_t x[16];
+      std::memcpy(x, state, sizeof(x));
+      for(int i_round = 0; i_round < 10; i_round++) {
+          chacha20_quarter(x[0], x[4], x[8], x[12]);
+          chacha20_quarter(x[1], x[5], x[9], x[13]);
+          chacha20_quarter(x[2], x[6], x[10], x[14]);
+          chacha20_quarter(x[3], x[7], x[11], x[15]);
+          chacha20_quarter(x[0], x[5], x[10], x[15]);
+          chacha20_quarter(x[1], x[6], x[11], x[12]);
+          chacha20_quarter(x[2], x[7], x[8], x[13]);
+          chacha20_quarter(x[3], x[4], x[9], x[14]);
+      }
+      for(int i_word = 0; i_word < 16; i_word++) {
+          std::uint32_t l_word = x[i_word] + state[i_word];
+          dst[i_word * 4 + 0] = l_word & 0xff;
+          dst[i_word * 4 + 1] = (l_word >> 8) & 0xff;
+          dst[i_word * 4 + 2] = (l_word >> 16) & 0xff;
+          dst[i_word * 4 + 3] = (l_word >> 24) & 0xff;
+      }
+      state[12]++;
+}
+
+static std::size_t chacha20_xor_none(std::uint8_t*, const std::uint8_t*, std::size_t, std::uint32_t*) noexcept
+{
+      return 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/* chacha20_quarter_ssse3()
+   quarter round on four blocks at once
+*/
+__attribute__((target("ssse3")))
+static inline void chacha20_quarter_ssse3(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i rot16, __m128i rot8) noexcept
+{
+      a = _mm_add_epi32(a, b); d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot16);
+      c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c);
+      b = _mm_or_si128(_mm_slli_epi32(b, 12), _mm_srli_epi32(b, 20));
+      a = _mm_add_epi32(a, b); d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot8);
+      c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c);
+      b = _mm_or_si128(_mm_slli_epi32(b, 7), _mm_srli_epi32(b, 25));
+}
+
+/* chacha20_xor_ssse3()
+   four blocks at a time: every vector holds the same state word of four consecutive blocks, so that the rounds are
+   plain lane-wise operations; 16 and 8 bit rotations are byte shuffles, the key stream is transposed back into block
+   order before being applied;
+   returns the number of bytes processed, a multiple of 4 blocks
+*/
+__attribute__((target("ssse3")))
+static std::size_t chacha20_xor_ssse3(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint32_t* state) noexcept
+{
+      std::size_t l_done = 0;
+      __m128i     l_rot16 = _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+      __m128i     l_rot8 = _mm_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+      while(size - l_done >= chacha20_block_size * 4) {
+          __m128i s[16];
+          __m128i x[16];
+          for(int i_word = 0; i_word < 16; i_word++) {
+              s[i_word] = _mm_set1_epi32(state[i_word]);
+          }
+          s[12] = _mm_add_epi32(s[12], _mm_set_epi32(3, 2, 1, 0));
+          for(int i_word = 0; i_word < 16; i_word++) {
+              x[i_word] = s[i_word];
+          }
+          for(int i_round = 0; i_round < 10; i_round++) {
+              chacha20_quarter_ssse3(x[0], x[4], x[8], x[12], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[1], x[5], x[9], x[13], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[2], x[6], x[10], x[14], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[3], x[7], x[11], x[15], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[0], x[5], x[10], x[15], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[1], x[6], x[11], x[12], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[2], x[7], x[8], x[13], l_rot16, l_rot8);
+              chacha20_quarter_ssse3(x[3], x[4], x[9], x[14], l_rot16, l_rot8);
+          }
+          for(int i_group = 0; i_group < 4; i_group++) {
+              __m128i a = _mm_add_epi32(x[i_group * 4 + 0], s[i_group * 4 + 0]);
+              __m128i b = _mm_add_epi32(x[i_group * 4 + 1], s[i_group * 4 + 1]);
+              __m128i c = _mm_add_epi32(x[i_group * 4 + 2], s[i_group * 4 + 2]);
+              __m128i d = _mm_add_epi32(x[i_group * 4 + 3], s[i_group * 4 + 3]);
+              __m128i ab_lo = _mm_unpacklo_epi32(a, b);
+              __m128i ab_hi = _mm_unpackhi_epi32(a, b);
+              __m128i cd_lo = _mm_unpacklo_epi32(c, d);
+              __m128i cd_hi = _mm_unpackhi_epi32(c, d);
+              __m128i l_block[4] = {
+                  _mm_unpacklo_epi64(ab_lo, cd_lo),
+                  _mm_unpackhi_epi64(ab_lo, cd_lo),
+                  _mm_unpacklo_epi64(ab_hi, cd_hi),
+                  _mm_unpackhi_epi64(ab_hi, cd_hi)
+              };
+              for(int i_block = 0; i_block < 4; i_block++) {
+                  std::size_t l_offset = l_done + i_block * chacha20_block_size + i_group * 16;
+                  __m128i     l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_offset));
+                  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + l_offset), _mm_xor_si128(l_data, l_block[i_block]));
+              }
+          }
+          state[12] += 4;
+          l_done += chacha20_block_size * 4;
+      }
+      return l_done;
+}
+
+/* chacha20_quarter_avx2()
+*/
+__attribute__((target("avx2")))
+static inline void chacha20_quarter_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i rot16, __m256i rot8) noexcept
+{
+      a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);
+      c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);
+      b = _mm256_or_si256(_mm256_slli_epi32(b, 12), _mm256_srli_epi32(b, 20));
+      a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);
+      c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);
+      b = _mm256_or_si256(_mm256_slli_epi32(b, 7), _mm256_srli_epi32(b, 25));
+}
+
+/* chacha20_xor_avx2()
+   same as chacha20_xor_ssse3(), eight blocks at a time: the low 128 bit lanes hold blocks 0-3, the high ones 4-7
+*/
+__attribute__((target("avx2")))
+static std::size_t chacha20_xor_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint32_t* state) noexcept
+{
+      std::size_t l_done = 0;
+      __m256i     l_rot16 = _mm256_set_epi8(
+          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2
+      );
+      __m256i     l_rot8 = _mm256_set_epi8(
+          14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+          14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3
+      );
+      while(size - l_done >= chacha20_block_size * 8) {
+          __m256i s[16];
+          __m256i x[16];
+          for(int i_word = 0; i_word < 16; i_word++) {
+              s[i_word] = _mm256_set1_epi32(state[i_word]);
+          }
+          s[12] = _mm256_add_epi32(s[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+          for(int i_word = 0; i_word < 16; i_word++) {
+              x[i_word] = s[i_word];
+          }
+          for(int i_round = 0; i_round < 10; i_round++) {
+              chacha20_quarter_avx2(x[0], x[4], x[8], x[12], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[1], x[5], x[9], x[13], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[2], x[6], x[10], x[14], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[3], x[7], x[11], x[15], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[0], x[5], x[10], x[15], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[1], x[6], x[11], x[12], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[2], x[7], x[8], x[13], l_rot16, l_rot8);
+              chacha20_quarter_avx2(x[3], x[4], x[9], x[14], l_rot16, l_rot8);
+          }
+          __m256i l_block[4][4];
+          for(int i_group = 0; i_group < 4; i_group++) {
+              __m256i a = _mm256_add_epi32(x[i_group * 4 + 0], s[i_group * 4 + 0]);
+              __m256i b = _mm256_add_epi32(x[i_group * 4 + 1], s[i_group * 4 + 1]);
+              __m256i c = _mm256_add_epi32(x[i_group * 4 + 2], s[i_group * 4 + 2]);
+              __m256i d = _mm256_add_epi32(x[i_group * 4 + 3], s[i_group * 4 + 3]);
+              __m256i ab_lo = _mm256_unpacklo_epi32(a, b);
+              __m256i ab_hi = _mm256_unpackhi_epi32(a, b);
+              __m256i cd_lo = _mm256_unpacklo_epi32(c, d);
+              __m256i cd_hi = _mm256_unpackhi_epi32(c, d);
+              l_block[i_group][0] = _mm256_unpacklo_epi64(ab_lo, cd_lo);
+              l_block[i_group][1] = _mm256_unpackhi_epi64(ab_lo, cd_lo);
+              l_block[i_group][2] = _mm256_unpacklo_epi64(ab_hi, cd_hi);
+              l_block[i_group][3] = _mm256_unpackhi_epi64(ab_hi, cd_hi);
+          }
+          for(int i_block = 0; i_block < 4; i_block++) {
+              // words 0-7 and 8-15 of block i (low lanes) and of block i + 4 (high lanes)
+              __m256i     l_lo = _mm256_permute2x128_si256(l_block[0][i_block], l_block[1][i_block], 0x20);
+              __m256i     l_hi = _mm256_permute2x128_si256(l_block[2][i_block], l_block[3][i_block], 0x20);
+              __m256i     l_lo_next = _mm256_permute2x128_si256(l_block[0][i_block], l_block[1][i_block], 0x31);
+              __m256i     l_hi_next = _mm256_permute2x128_si256(l_block[2][i_block], l_block[3][i_block], 0x31);
+              std::size_t l_offset = l_done + i_block * chacha20_block_size;
+              std::size_t l_offset_next = l_offset + chacha20_block_size * 4;
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + l_offset),
+                  _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_offset)), l_lo));
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + l_offset + 32),
+                  _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_offset + 32)), l_hi));
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + l_offset_next),
+                  _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_offset_next)), l_lo_next));
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + l_offset_next + 32),
+                  _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_offset_next + 32)), l_hi_next));
+          }
+          state[12] += 8;
+          l_done += chacha20_block_size * 8;
+      }
+      _mm256_zeroupper();
+      return l_done + chacha20_xor_ssse3(dst + l_done, src + l_done, size - l_done, state);
+}
+#endif
+
+/* chacha20_kernel_t
+   vector kernel picked once, at load time, from the features reported by cpuid
+*/
+struct chacha20_kernel_t
+{
+  std::size_t (*xor_blocks)(std::uint8_t*, const std::uint8_t*, std::size_t, std::uint32_t*) noexcept;
+  const char*   name;
+};
+
+/* chacha20_get_kernel()
+   pick the widest kernel the cpu supports; EMC_NO_SIMD in the environment forces the scalar implementation, as it does
+   for the codecs
+*/
+static chacha20_kernel_t chacha20_get_kernel() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+      if(std::getenv("EMC_NO_SIMD") == nullptr) {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx2")) {
+              return {chacha20_xor_avx2, "avx2"};
+          }
+          if(__builtin_cpu_supports("ssse3")) {
+              return {chacha20_xor_ssse3, "ssse3"};
+          }
+      }
+#endif
+      return {chacha20_xor_none, "scalar"};
+}
+
+static const chacha20_kernel_t s_chacha20_kernel = chacha20_get_kernel();
+
+const char* chacha20_get_kernel_name() noexcept
+{
+      return s_chacha20_kernel.name;
+}
+
+/* chacha20_xor()
+   RFC 8439 ChaCha20: xor `size` bytes with the key stream for `key` and `nonce`, starting at block `counter`;
+   `dst` may be the same as `src`, for encrypting in place
+*/
+void  chacha20_xor(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, const std::uint8_t* key, const std::uint8_t* nonce, std::uint32_t counter) noexcept
+{
+      std::uint32_t l_state[16];
+      std::uint8_t  l_block[chacha20_block_size];
+      std::size_t   l_done;
+      chacha20_init(l_state, key, nonce, counter);
+      l_done = s_chacha20_kernel.xor_blocks(dst, src, size, l_state);
+      while(l_done < size) {
+          std::size_t l_size = size - l_done;
+          if(l_size > chacha20_block_size) {
+              l_size = chacha20_block_size;
+          }
+          chacha20_block_scalar(l_block, l_state);
+          for(std::size_t i_byte = 0; i_byte < l_size; i_byte++) {
+              dst[l_done + i_byte] = src[l_done + i_byte] ^ l_block[i_byte];
+          }
+          l_done += l_size;
+      }
+}
+
+/* chacha20_block()
+   single block of key stream, i.e. to derive the one time Poly1305 key
+*/
+void  chacha20_block(std::uint8_t* dst, const std::uint8_t* key, const std::uint8_t* nonce, std::uint32_t counter) noexcept
+{
+      std::uint32_t l_state[16];
+      chacha20_init(l_state, key, nonce, counter);
+      chacha20_block_scalar(dst, l_state);
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
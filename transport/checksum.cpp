@@ -0,0 +1,233 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "checksum.h"
+#include <emc/buffer.h>
+#include <emc/error.h>
+#include <emc/transport.h>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+static inline void checksum_put(std::uint8_t* dst, std::uint32_t crc) noexcept
+{
+      dst[0] = crc & 0xff;
+      dst[1] = (crc >> 8) & 0xff;
+      dst[2] = (crc >> 16) & 0xff;
+      dst[3] = (crc >> 24) & 0xff;
+}
+
+static inline std::uint32_t checksum_get(const std::uint8_t* src) noexcept
+{
+      return src[0] | (src[1] << 8) | (src[2] << 16) | (static_cast<std::uint32_t>(src[3]) << 24);
+}
+
+      checksum::checksum() noexcept:
+      stage(),
+      m_fault_count(0),
+      m_fault_streak(0),
+      m_plain_bit(false)
+{
+}
+
+      checksum::~checksum()
+{
+}
+
+void  checksum::emi_fault() noexcept
+{
+      m_fault_count++;
+      m_fault_streak++;
+      if(m_fault_streak >= fault_streak_max) {
+          // too many in a row to be line noise
+          m_fault_streak = 0;
+          emc_raw_post(event::soft_fault);
+      }
+}
+
+/* emi_verify()
+   check the marker and the tag of an inbound tagged frame and keep track of the faults; a good frame also tells whether
+   the peer accepts untagged frames
+*/
+bool  checksum::emi_verify(const std::uint8_t* data, std::size_t size) noexcept
+{
+      if(size >= tag_size + 1) {
+          if((data[0] == frame_checked) ||
+              (data[0] == frame_ready)) {
+              if(crc32c(0, data, size - tag_size) == checksum_get(data + size - tag_size)) {
+                  m_fault_streak = 0;
+                  m_plain_bit = (data[0] == frame_ready);
+                  return true;
+              }
+          }
+      }
+      emi_fault();
+      return false;
+}
+
+/* emi_is_plain()
+   whether outbound frames can go untagged: both ends have to be within ring_machine, and this end only knows about the
+   other one once it received a frame_ready from it
+*/
+bool  checksum::emi_is_plain() const noexcept
+{
+      return m_plain_bit && has_ring(ring_machine);
+}
+
+auto  checksum::emi_get_marker() const noexcept -> std::uint8_t
+{
+      if(has_ring(ring_machine)) {
+          return frame_ready;
+      }
+      return frame_checked;
+}
+
+/* emc_raw_recv()
+   both kinds of frames are taken regardless of the ring this end is in, so that the frames still in flight when
+   either end switches are not lost; untagged ones are only trusted while within ring_machine though, as the peer
+   would not send any otherwise
+*/
+int   checksum::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if((size > 0) &&
+          (data[0] == frame_plain)) {
+          if(has_ring(ring_machine)) {
+              // the peer only sends these from within ring_machine, where it takes them as well
+              m_plain_bit = true;
+              return stage::emc_raw_recv(bus, data + 1, size - 1);
+          }
+          emi_fault();
+          return err_parse;
+      }
+      if(emi_verify(data, size)) {
+          return stage::emc_raw_recv(bus, data + 1, size - tag_size - 1);
+      }
+      return err_parse;
+}
+
+/* emc_raw_send()
+   the frame is built onto a copy of the message in scratch memory; messages travelling as buffers get it in place
+*/
+int   checksum::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      std::uint8_t* l_frame_ptr;
+      if(emi_is_plain()) {
+          l_frame_ptr = emc_get_scratch(size + 1);
+          if(l_frame_ptr == nullptr) {
+              return err_fail;
+          }
+          l_frame_ptr[0] = frame_plain;
+          std::memcpy(l_frame_ptr + 1, data, size);
+          return stage::emc_raw_send(bus, l_frame_ptr, size + 1);
+      }
+      l_frame_ptr = emc_get_scratch(size + tag_size + 1);
+      if(l_frame_ptr == nullptr) {
+          return err_fail;
+      }
+      l_frame_ptr[0] = emi_get_marker();
+      std::memcpy(l_frame_ptr + 1, data, size);
+      checksum_put(l_frame_ptr + size + 1, crc32c(0, l_frame_ptr, size + 1));
+      return stage::emc_raw_send(bus, l_frame_ptr, size + tag_size + 1);
+}
+
+int   checksum::emc_raw_recv_buffer(int bus, buffer* buffer) noexcept
+{
+      std::uint8_t* l_data_ptr = buffer->get_data();
+      std::size_t   l_data_size = buffer->get_size();
+      if(buffer->is_shared()) {
+          return emc_raw_recv(bus, l_data_ptr, l_data_size);
+      }
+      if((l_data_size > 0) &&
+          (l_data_ptr[0] == frame_plain)) {
+          if(has_ring(ring_machine)) {
+              m_plain_bit = true;
+              buffer->pull(1);
+              return emc_raw_forward_buffer(bus, buffer);
+          }
+          emi_fault();
+          return err_parse;
+      }
+      if(emi_verify(l_data_ptr, l_data_size)) {
+          buffer->pull(1);
+          buffer->trim(tag_size);
+          return emc_raw_forward_buffer(bus, buffer);
+      }
+      return err_parse;
+}
+
+int   checksum::emc_raw_send_buffer(int bus, buffer* buffer) noexcept
+{
+      if(buffer->is_shared() == false) {
+          if(emi_is_plain()) {
+              std::uint8_t* l_mark_ptr = buffer->push(1);
+              if(l_mark_ptr != nullptr) {
+                  l_mark_ptr[0] = frame_plain;
+                  return emc_raw_return_buffer(bus, buffer);
+              }
+          } else
+          if((buffer->get_headroom() >= 1) &&
+              (buffer->get_tailroom() >= tag_size)) {
+              std::uint8_t* l_mark_ptr = buffer->push(1);
+              std::uint8_t* l_tag_ptr;
+              l_mark_ptr[0] = emi_get_marker();
+              l_tag_ptr = buffer->put(tag_size);
+              checksum_put(l_tag_ptr, crc32c(0, buffer->get_data(), buffer->get_size() - tag_size));
+              return emc_raw_return_buffer(bus, buffer);
+          }
+      }
+      return emc_raw_send(bus, buffer->get_data(), buffer->get_size());
+}
+
+/* emc_raw_proto_down()
+   whether the peer takes untagged frames only holds for the session it said so in
+*/
+void  checksum::emc_raw_proto_down() noexcept
+{
+      m_plain_bit = false;
+}
+
+void  checksum::emc_raw_drop() noexcept
+{
+      m_plain_bit = false;
+}
+
+auto  checksum::get_name() const noexcept -> const char*
+{
+      return "checksum";
+}
+
+/* get_fault_count()
+   number of inbound frames rejected so far
+*/
+unsigned int checksum::get_fault_count() const noexcept
+{
+      return m_fault_count;
+}
+
+void  checksum::reset_fault_count() noexcept
+{
+      m_fault_count = 0;
+      m_fault_streak = 0;
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -0,0 +1,90 @@
+#ifndef emc_transport_checksum_h
+#define emc_transport_checksum_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/stage.h>
+
+namespace emc {
+namespace transport {
+
+/* checksum
+   Integrity stage: appends a CRC-32C to outbound messages and verifies and strips it from inbound ones, so that frames
+   corrupted on the link are dropped at the edge of the pipeline; isolated bad frames are only counted, a run of them
+   is reported as a soft fault.
+   Between peers within ring_machine the tag is left out; since the two ends learn about the ring each on their own,
+   every frame starts with a marker byte telling whether it is tagged, and a side only starts sending untagged frames
+   once a tagged frame from the peer has told it that the peer is within ring_machine as well, and thus accepts them.
+*/
+class checksum: public emc::stage
+{
+  unsigned int    m_fault_count;
+  int             m_fault_streak;
+  bool            m_plain_bit;
+
+  public:
+  static constexpr std::size_t tag_size = 4u;
+
+  /* frame_*
+     marker byte at the start of every frame: tagged frames are covered by the tag, marker included, and either say that
+     the sender accepts untagged frames (frame_ready) or not (frame_checked)
+  */
+  static constexpr std::uint8_t frame_checked = 0x5au;
+  static constexpr std::uint8_t frame_ready = 0x5bu;
+  static constexpr std::uint8_t frame_plain = 0xa5u;
+
+  /* fault_streak_max
+     how many bad frames in a row make a soft fault
+  */
+  static constexpr int  fault_streak_max = 8;
+
+  private:
+          void    emi_fault() noexcept;
+          bool    emi_verify(const std::uint8_t*, std::size_t) noexcept;
+          bool    emi_is_plain() const noexcept;
+          auto    emi_get_marker() const noexcept -> std::uint8_t;
+
+  protected:
+  virtual int     emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_send(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_recv_buffer(int, buffer*) noexcept override;
+  virtual int     emc_raw_send_buffer(int, buffer*) noexcept override;
+  virtual void    emc_raw_proto_down() noexcept override;
+  virtual void    emc_raw_drop() noexcept override;
+
+  public:
+          checksum() noexcept;
+          checksum(const checksum&) noexcept = delete;
+          checksum(checksum&&) noexcept = delete;
+  virtual ~checksum();
+
+  virtual const char* get_name() const noexcept override;
+          unsigned int get_fault_count() const noexcept;
+          void    reset_fault_count() noexcept;
+
+          checksum& operator=(const checksum&) noexcept = delete;
+          checksum& operator=(checksum&&) noexcept = delete;
+};
+
+/*namespace transport*/ }
+/*namespace emc*/ }
+#endif
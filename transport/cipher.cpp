@@ -0,0 +1,251 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "cipher.h"
+#include <emc/buffer.h>
+#include <emc/error.h>
+#include <cstring>
+#include <limits>
+
+namespace emc {
+namespace transport {
+
+/* cipher_make_nonce()
+   the nonce is the 64 bit sequence number, preceded by 4 zero bytes; keys differ per direction, so a nonce is never
+   used twice with the same key as long as sequence numbers are not
+*/
+static inline void cipher_make_nonce(std::uint8_t* nonce, const std::uint8_t* seq) noexcept
+{
+      std::memset(nonce, 0, chacha20_nonce_size - cipher::seq_size);
+      std::memcpy(nonce + chacha20_nonce_size - cipher::seq_size, seq, cipher::seq_size);
+}
+
+      cipher::cipher() noexcept:
+      stage(),
+      m_send_seq(0),
+      m_recv_seq(0),
+      m_recv_mask(0),
+      m_fault_count(0),
+      m_session_bit(false)
+{
+      std::memset(m_send_key, 0, sizeof(m_send_key));
+      std::memset(m_recv_key, 0, sizeof(m_recv_key));
+}
+
+      cipher::~cipher()
+{
+      clear_session();
+}
+
+/* emi_open()
+   authenticate and decrypt a whole frame in place, checking its sequence number against the replay window; the window
+   only moves once the frame is known to be genuine
+*/
+bool  cipher::emi_open(std::uint8_t* data, std::size_t size) noexcept
+{
+      if(size >= overhead_size) {
+          std::uint8_t  l_nonce[chacha20_nonce_size];
+          std::uint64_t l_seq = 0;
+          for(int i_byte = seq_size - 1; i_byte >= 0; i_byte--) {
+              l_seq = (l_seq << 8) | data[i_byte];
+          }
+          if(l_seq <= m_recv_seq) {
+              // sequence numbers start at 1, the window is empty as long as none was received
+              if((l_seq == 0) ||
+                  (m_recv_seq - l_seq >= replay_window_size) ||
+                  (m_recv_mask & (1ull << (m_recv_seq - l_seq)))) {
+                  m_fault_count++;
+                  return false;
+              }
+          }
+          cipher_make_nonce(l_nonce, data);
+          if(chacha20_poly1305_open(data + size - tag_size, data + seq_size, size - overhead_size, data, seq_size, m_recv_key, l_nonce)) {
+              if(l_seq > m_recv_seq) {
+                  if(l_seq - m_recv_seq < replay_window_size) {
+                      m_recv_mask <<= l_seq - m_recv_seq;
+                  } else
+                      m_recv_mask = 0;
+                  m_recv_mask |= 1;
+                  m_recv_seq = l_seq;
+              } else
+                  m_recv_mask |= 1ull << (m_recv_seq - l_seq);
+              return true;
+          }
+      }
+      m_fault_count++;
+      return false;
+}
+
+/* emi_seal()
+   encrypt a frame in place: `data` points at the room for the sequence number, followed by `size` bytes of message and
+   room for the tag
+*/
+bool  cipher::emi_seal(std::uint8_t* data, std::size_t size) noexcept
+{
+      std::uint8_t  l_nonce[chacha20_nonce_size];
+      std::uint64_t l_seq;
+      if(m_send_seq == std::numeric_limits<std::uint64_t>::max()) {
+          // out of nonces: the session needs new keys
+          return false;
+      }
+      l_seq = ++m_send_seq;
+      for(std::size_t i_byte = 0; i_byte < seq_size; i_byte++) {
+          data[i_byte] = l_seq >> (i_byte * 8);
+      }
+      cipher_make_nonce(l_nonce, data);
+      chacha20_poly1305_seal(data + seq_size + size, data + seq_size, size, data, seq_size, m_send_key, l_nonce);
+      return true;
+}
+
+/* emc_raw_recv()
+   inbound frames are decrypted in place
+*/
+int   cipher::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(m_session_bit) {
+          if(emi_open(data, size)) {
+              return stage::emc_raw_recv(bus, data + seq_size, size - overhead_size);
+          }
+          return err_parse;
+      }
+      return stage::emc_raw_recv(bus, data, size);
+}
+
+/* emc_raw_send()
+   outbound messages are framed and encrypted in scratch memory, leaving the original untouched; messages travelling as
+   buffers are encrypted in place, into their head and tail room
+*/
+int   cipher::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(m_session_bit) {
+          std::uint8_t* l_frame_ptr = emc_get_scratch(size + overhead_size);
+          if(l_frame_ptr == nullptr) {
+              return err_fail;
+          }
+          std::memcpy(l_frame_ptr + seq_size, data, size);
+          if(emi_seal(l_frame_ptr, size)) {
+              return stage::emc_raw_send(bus, l_frame_ptr, size + overhead_size);
+          }
+          return err_refuse;
+      }
+      return stage::emc_raw_send(bus, data, size);
+}
+
+/* emc_raw_recv_buffer()
+   buffers held by this stage alone are decrypted in place; shared ones are decrypted from a copy in scratch memory,
+   since the other holders still reference the ciphertext
+*/
+int   cipher::emc_raw_recv_buffer(int bus, buffer* buffer) noexcept
+{
+      if(m_session_bit) {
+          if(buffer->is_shared() == false) {
+              if(emi_open(buffer->get_data(), buffer->get_size())) {
+                  buffer->pull(seq_size);
+                  buffer->trim(tag_size);
+                  return emc_raw_forward_buffer(bus, buffer);
+              }
+              return err_parse;
+          }
+          std::uint8_t* l_frame_ptr = emc_get_scratch(buffer->get_size());
+          if(l_frame_ptr == nullptr) {
+              return err_fail;
+          }
+          std::memcpy(l_frame_ptr, buffer->get_data(), buffer->get_size());
+          return emc_raw_recv(bus, l_frame_ptr, buffer->get_size());
+      }
+      return emc_raw_recv(bus, buffer->get_data(), buffer->get_size());
+}
+
+int   cipher::emc_raw_send_buffer(int bus, buffer* buffer) noexcept
+{
+      if(m_session_bit) {
+          if((buffer->is_shared() == false) &&
+              (buffer->get_headroom() >= seq_size) &&
+              (buffer->get_tailroom() >= tag_size)) {
+              std::size_t l_size = buffer->get_size();
+              buffer->push(seq_size);
+              buffer->put(tag_size);
+              if(emi_seal(buffer->get_data(), l_size)) {
+                  return emc_raw_return_buffer(bus, buffer);
+              }
+              return err_refuse;
+          }
+      }
+      return emc_raw_send(bus, buffer->get_data(), buffer->get_size());
+}
+
+/* emc_raw_drop()
+   the session does not survive the connection
+*/
+void  cipher::emc_raw_drop() noexcept
+{
+      clear_session();
+}
+
+auto  cipher::get_name() const noexcept -> const char*
+{
+      return "cipher";
+}
+
+/* set_session()
+   start a new session with a pair of keys, chacha20_key_size bytes each: `send_key` for outbound messages, `recv_key`
+   for inbound ones; the peer uses the same pair the other way around
+*/
+void  cipher::set_session(const std::uint8_t* send_key, const std::uint8_t* recv_key) noexcept
+{
+      std::memcpy(m_send_key, send_key, sizeof(m_send_key));
+      std::memcpy(m_recv_key, recv_key, sizeof(m_recv_key));
+      m_send_seq = 0;
+      m_recv_seq = 0;
+      m_recv_mask = 0;
+      m_session_bit = true;
+}
+
+bool  cipher::has_session() const noexcept
+{
+      return m_session_bit;
+}
+
+void  cipher::clear_session() noexcept
+{
+      // volatile, so that wiping the keys is not optimized away as a dead store
+      volatile std::uint8_t* p_send_key = m_send_key;
+      volatile std::uint8_t* p_recv_key = m_recv_key;
+      for(std::size_t i_byte = 0; i_byte < chacha20_key_size; i_byte++) {
+          p_send_key[i_byte] = 0;
+          p_recv_key[i_byte] = 0;
+      }
+      m_send_seq = 0;
+      m_recv_seq = 0;
+      m_recv_mask = 0;
+      m_session_bit = false;
+}
+
+/* get_fault_count()
+   number of inbound frames dropped for failing authentication or replay checks
+*/
+unsigned int cipher::get_fault_count() const noexcept
+{
+      return m_fault_count;
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
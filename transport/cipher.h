@@ -0,0 +1,87 @@
+#ifndef emc_transport_cipher_h
+#define emc_transport_cipher_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/stage.h>
+#include <emc/transport.h>
+
+namespace emc {
+namespace transport {
+
+/* cipher
+   Authenticated encryption stage (RFC 8439 ChaCha20-Poly1305): every outbound message is encrypted and framed with a
+   sequence number up front and the authentication tag at the back; inbound frames that fail authentication, or whose
+   sequence number was already seen, are dropped;
+   the session keys (one per direction, crosswise between the peers) are handed in by whichever layer ran the key
+   exchange, until then the stage is transparent
+*/
+class cipher: public emc::stage
+{
+  std::uint8_t    m_send_key[chacha20_key_size];
+  std::uint8_t    m_recv_key[chacha20_key_size];
+  std::uint64_t   m_send_seq;
+  std::uint64_t   m_recv_seq;
+  std::uint64_t   m_recv_mask;
+  unsigned int    m_fault_count;
+  bool            m_session_bit;
+
+  public:
+  static constexpr std::size_t seq_size = 8u;
+  static constexpr std::size_t tag_size = poly1305::tag_size;
+  static constexpr std::size_t overhead_size = seq_size + tag_size;
+
+  /* replay_window_size
+     how far behind the most recent one a sequence number may arrive and still be accepted (once)
+  */
+  static constexpr std::uint64_t replay_window_size = 64u;
+
+  private:
+          bool    emi_open(std::uint8_t*, std::size_t) noexcept;
+          bool    emi_seal(std::uint8_t*, std::size_t) noexcept;
+
+  protected:
+  virtual int     emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_send(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_recv_buffer(int, buffer*) noexcept override;
+  virtual int     emc_raw_send_buffer(int, buffer*) noexcept override;
+  virtual void    emc_raw_drop() noexcept override;
+
+  public:
+          cipher() noexcept;
+          cipher(const cipher&) noexcept = delete;
+          cipher(cipher&&) noexcept = delete;
+  virtual ~cipher();
+
+  virtual const char* get_name() const noexcept override;
+          void    set_session(const std::uint8_t*, const std::uint8_t*) noexcept;
+          bool    has_session() const noexcept;
+          void    clear_session() noexcept;
+          unsigned int get_fault_count() const noexcept;
+
+          cipher& operator=(const cipher&) noexcept = delete;
+          cipher& operator=(cipher&&) noexcept = delete;
+};
+
+/*namespace transport*/ }
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,303 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace emc {
+namespace transport {
+
+/* cobs_block_size_max
+   longest run of data bytes a single code byte can describe
+*/
+static constexpr std::size_t cobs_block_size_max = 254;
+
+/* cobs_scan_scalar()
+   returns the offset of the first byte equal to `value`, or `size` if there is none
+*/
+static std::size_t cobs_scan_scalar(const std::uint8_t* src, std::size_t size, std::uint8_t value) noexcept
+{
+      std::size_t l_done = 0;
+      while(l_done < size) {
+          if(src[l_done] == value) {
+              break;
+          }
+          l_done++;
+      }
+      return l_done;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/* cobs_scan_sse2()
+   compare 16 bytes at a time; returns the offset of the first byte equal to `value` or, if there is none, the number
+   of bytes scanned
+*/
+__attribute__((target("sse2")))
+static std::size_t cobs_scan_sse2(const std::uint8_t* src, std::size_t size, std::uint8_t value) noexcept
+{
+      std::size_t l_done = 0;
+      __m128i     l_value = _mm_set1_epi8(value);
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          int     l_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(l_data, l_value));
+          if(l_mask) {
+              return l_done + __builtin_ctz(l_mask);
+          }
+          l_done += 16;
+      }
+      return l_done;
+}
+
+/* cobs_copy_sse2()
+   flip 16 bytes at a time with the delimiter; returns the number of bytes copied
+*/
+__attribute__((target("sse2")))
+static std::size_t cobs_copy_sse2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint8_t delimiter) noexcept
+{
+      std::size_t l_done = 0;
+      __m128i     l_delimiter = _mm_set1_epi8(delimiter);
+      while(size - l_done >= 16) {
+          __m128i l_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l_done));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + l_done), _mm_xor_si128(l_data, l_delimiter));
+          l_done += 16;
+      }
+      return l_done;
+}
+
+/* cobs_scan_avx2()
+*/
+__attribute__((target("avx2")))
+static std::size_t cobs_scan_avx2(const std::uint8_t* src, std::size_t size, std::uint8_t value) noexcept
+{
+      std::size_t l_done = 0;
+      __m256i     l_value = _mm256_set1_epi8(value);
+      while(size - l_done >= 32) {
+          __m256i      l_data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          unsigned int l_mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_data, l_value));
+          if(l_mask) {
+              return l_done + __builtin_ctz(l_mask);
+          }
+          l_done += 32;
+      }
+      _mm256_zeroupper();
+      return l_done + cobs_scan_sse2(src + l_done, size - l_done, value);
+}
+
+/* cobs_copy_avx2()
+*/
+__attribute__((target("avx2")))
+static std::size_t cobs_copy_avx2(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint8_t delimiter) noexcept
+{
+      std::size_t l_done = 0;
+      __m256i     l_delimiter = _mm256_set1_epi8(delimiter);
+      while(size - l_done >= 32) {
+          __m256i l_data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + l_done));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + l_done), _mm256_xor_si256(l_data, l_delimiter));
+          l_done += 32;
+      }
+      _mm256_zeroupper();
+      return l_done + cobs_copy_sse2(dst + l_done, src + l_done, size - l_done, delimiter);
+}
+#endif
+
+/* cobs_kernel_t
+   vector kernels picked once, at load time, from the features reported by cpuid
+*/
+struct cobs_kernel_t
+{
+  std::size_t (*scan)(const std::uint8_t*, std::size_t, std::uint8_t) noexcept;
+  std::size_t (*copy)(std::uint8_t*, const std::uint8_t*, std::size_t, std::uint8_t) noexcept;
+  const char*   name;
+};
+
+static std::size_t cobs_scan_none(const std::uint8_t*, std::size_t, std::uint8_t) noexcept
+{
+      return 0;
+}
+
+static std::size_t cobs_copy_none(std::uint8_t*, const std::uint8_t*, std::size_t, std::uint8_t) noexcept
+{
+      return 0;
+}
+
+/* cobs_get_kernel()
+   pick the widest kernel the cpu supports; setting EMC_NO_SIMD in the environment forces the scalar implementation, so
+   that both can be measured on the same machine
+*/
+static cobs_kernel_t cobs_get_kernel() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+      if(std::getenv("EMC_NO_SIMD") == nullptr) {
+          __builtin_cpu_init();
+          if(__builtin_cpu_supports("avx2")) {
+              return {cobs_scan_avx2, cobs_copy_avx2, "avx2"};
+          }
+          if(__builtin_cpu_supports("sse2")) {
+              return {cobs_scan_sse2, cobs_copy_sse2, "sse2"};
+          }
+      }
+#endif
+      return {cobs_scan_none, cobs_copy_none, "scalar"};
+}
+
+static const cobs_kernel_t s_cobs_kernel = cobs_get_kernel();
+
+const char* cobs_get_kernel_name() noexcept
+{
+      return s_cobs_kernel.name;
+}
+
+/* cobs_scan()
+   find the first byte equal to `value`; returns its offset or `size` if there is none
+*/
+static inline std::size_t cobs_scan(const std::uint8_t* src, std::size_t size, std::uint8_t value) noexcept
+{
+      std::size_t l_done = s_cobs_kernel.scan(src, size, value);
+      if(l_done < size) {
+          if(src[l_done] == value) {
+              return l_done;
+          }
+          return l_done + cobs_scan_scalar(src + l_done, size - l_done, value);
+      }
+      return size;
+}
+
+/* cobs_copy()
+   copy a run of data bytes, flipping them with the delimiter
+*/
+static inline void cobs_copy(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint8_t delimiter) noexcept
+{
+      if(delimiter == 0) {
+          if(size > 0) {
+              std::memcpy(dst, src, size);
+          }
+      } else {
+          std::size_t i_byte = s_cobs_kernel.copy(dst, src, size, delimiter);
+          while(i_byte < size) {
+              dst[i_byte] = src[i_byte] ^ delimiter;
+              i_byte++;
+          }
+      }
+}
+
+/* cobs_get_encode_size()
+   upper bound of the size of `size` bytes once encoded
+*/
+std::size_t cobs_get_encode_size(std::size_t size) noexcept
+{
+      return size + size / cobs_block_size_max + 1;
+}
+
+/* cobs_encode()
+   consistent overhead byte stuffing: the input is cut at every zero byte into runs of at most 254 data bytes, each one
+   prefixed with a code byte giving its length, so that the output holds no zero bytes at all; the output is then
+   flipped with `delimiter` (i.e. '\n') so it is the delimiter rather than zero that never appears, and the encoded
+   packet can share a link with text framed by that delimiter;
+   returns the number of bytes written to `dst`, at most cobs_get_encode_size(size)
+*/
+std::size_t cobs_encode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::uint8_t delimiter) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      while(true) {
+          std::size_t l_block_size = size;
+          if(l_block_size > cobs_block_size_max) {
+              l_block_size = cobs_block_size_max;
+          }
+          std::size_t l_run_size = cobs_scan(src, l_block_size, 0);
+          *(p_dst++) = (l_run_size + 1) ^ delimiter;
+          cobs_copy(p_dst, src, l_run_size, delimiter);
+          p_dst += l_run_size;
+          if(l_run_size < l_block_size) {
+              // skip the zero byte, implied by the code byte; a trailing one still needs an (empty) block to follow
+              src  += l_run_size + 1;
+              size -= l_run_size + 1;
+              if(size == 0) {
+                  *(p_dst++) = 1 ^ delimiter;
+                  break;
+              }
+          } else
+          if(l_run_size == cobs_block_size_max) {
+              src  += l_run_size;
+              size -= l_run_size;
+              if(size == 0) {
+                  break;
+              }
+          } else
+              break;
+      }
+      return p_dst - dst;
+}
+
+std::size_t cobs_encode(std::uint8_t* dst, const char* src, std::size_t size, std::uint8_t delimiter) noexcept
+{
+      return cobs_encode(dst, reinterpret_cast<const std::uint8_t*>(src), size, delimiter);
+}
+
+/* cobs_decode()
+   reverse cobs_encode(), given the same `delimiter`; decodes up to the first malformed block (one holding the
+   delimiter, or running past the end of the input) and stores the position of the offending byte (respectively the
+   code byte) in `offset`, or `size` if the whole input was valid;
+   returns the number of bytes written to `dst`, which is at most `size`
+*/
+std::size_t cobs_decode(std::uint8_t* dst, const std::uint8_t* src, std::size_t size, std::size_t& offset, std::uint8_t delimiter) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      std::size_t   l_done = 0;
+      while(l_done < size) {
+          std::size_t l_code = src[l_done] ^ delimiter;
+          std::size_t l_run_size = l_code - 1;
+          std::size_t l_run_error;
+          if(l_code == 0) {
+              offset = l_done;
+              return p_dst - dst;
+          }
+          if(l_run_size > size - l_done - 1) {
+              offset = l_done;
+              return p_dst - dst;
+          }
+          l_run_error = cobs_scan(src + l_done + 1, l_run_size, delimiter);
+          if(l_run_error < l_run_size) {
+              offset = l_done + 1 + l_run_error;
+              return p_dst - dst;
+          }
+          cobs_copy(p_dst, src + l_done + 1, l_run_size, delimiter);
+          p_dst  += l_run_size;
+          l_done += l_code;
+          if((l_run_size < cobs_block_size_max) && (l_done < size)) {
+              *(p_dst++) = 0;
+          }
+      }
+      offset = size;
+      return p_dst - dst;
+}
+
+std::size_t cobs_decode(std::uint8_t* dst, const char* src, std::size_t size, std::size_t& offset, std::uint8_t delimiter) noexcept
+{
+      return cobs_decode(dst, reinterpret_cast<const std::uint8_t*>(src), size, offset, delimiter);
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
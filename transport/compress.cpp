@@ -0,0 +1,208 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "compress.h"
+#include <emc/error.h>
+#include <cmath>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+/* entropy_sample_size
+   how many bytes of a message get_entropy() looks at
+*/
+static constexpr std::size_t entropy_sample_size = 256u;
+
+/* header_size_max
+   frame tag, followed by the decompressed size of the message as a base 128 varint
+*/
+static constexpr std::size_t header_size_max = 1 + 10;
+
+      compress::compress() noexcept:
+      stage(),
+      m_table(),
+      m_peer_bit(false)
+{
+}
+
+      compress::~compress()
+{
+}
+
+/* emi_is_enabled()
+   messages are framed only once the peer is known to support it; between peers on the same machine they are still
+   framed, only always stored (see emc_raw_send()), so that the two ends do not need to agree on when either of them
+   learnt about the ring
+*/
+bool  compress::emi_is_enabled() const noexcept
+{
+      return m_peer_bit;
+}
+
+/* emc_raw_recv()
+   unwrap an inbound frame: stored messages are passed on in place, compressed ones are expanded into scratch memory
+*/
+int   compress::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(emi_is_enabled()) {
+          if(size == 0) {
+              return err_parse;
+          }
+          if(data[0] == frame_stored) {
+              return stage::emc_raw_recv(bus, data + 1, size - 1);
+          } else
+          if(data[0] == frame_packed) {
+              std::size_t   l_head_size = 1;
+              std::size_t   l_data_size = 0;
+              std::size_t   l_error_offset;
+              std::uint8_t* l_data_ptr;
+              int           l_shift = 0;
+              while(true) {
+                  if((l_head_size >= size) ||
+                      (l_shift > 63)) {
+                      return err_parse;
+                  }
+                  l_data_size |= static_cast<std::size_t>(data[l_head_size] & 0x7f) << l_shift;
+                  if((data[l_head_size++] & 0x80) == 0) {
+                      break;
+                  }
+                  l_shift += 7;
+              }
+              l_data_ptr = emc_get_scratch(l_data_size);
+              if(l_data_ptr == nullptr) {
+                  return err_fail;
+              }
+              if(lz_decode(l_data_ptr, l_data_size, data + l_head_size, size - l_head_size, l_error_offset) != l_data_size) {
+                  return err_parse;
+              }
+              if(l_error_offset != size - l_head_size) {
+                  return err_parse;
+              }
+              return stage::emc_raw_recv(bus, l_data_ptr, l_data_size);
+          }
+          return err_parse;
+      }
+      return stage::emc_raw_recv(bus, data, size);
+}
+
+/* emc_raw_send()
+   wrap an outbound message into a frame, compressed unless it is too short, looks too random, simply does not get any
+   shorter, or the peer is within ring_machine, where copying is cheaper than compressing; the frame is built in scratch
+   memory
+*/
+int   compress::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(emi_is_enabled()) {
+          std::uint8_t* l_frame_ptr = emc_get_scratch(size + 1);
+          std::size_t   l_frame_size = 0;
+          if(l_frame_ptr == nullptr) {
+              return err_fail;
+          }
+          if((size >= size_min) &&
+              (size > header_size_max) &&
+              (has_ring(ring_machine) == false) &&
+              (get_entropy(data, size) <= entropy_max)) {
+              std::size_t l_head_size = 1;
+              std::size_t l_data_size = size;
+              std::size_t l_pack_size;
+              l_frame_ptr[0] = frame_packed;
+              while(l_data_size >= 0x80) {
+                  l_frame_ptr[l_head_size++] = (l_data_size & 0x7f) | 0x80;
+                  l_data_size >>= 7;
+              }
+              l_frame_ptr[l_head_size++] = l_data_size;
+              // only keep the compressed frame if it comes out shorter than the stored one would be
+              l_pack_size = lz_encode(l_frame_ptr + l_head_size, size + 1 - l_head_size, data, size, m_table);
+              if(l_pack_size > 0) {
+                  l_frame_size = l_head_size + l_pack_size;
+              }
+          }
+          if(l_frame_size == 0) {
+              l_frame_ptr[0] = frame_stored;
+              std::memcpy(l_frame_ptr + 1, data, size);
+              l_frame_size = size + 1;
+          }
+          return stage::emc_raw_send(bus, l_frame_ptr, l_frame_size);
+      }
+      return stage::emc_raw_send(bus, data, size);
+}
+
+/* emc_raw_proto_down()
+   support is negotiated per peer, forget about it when the peer goes away
+*/
+void  compress::emc_raw_proto_down() noexcept
+{
+      m_peer_bit = false;
+}
+
+void  compress::emc_raw_drop() noexcept
+{
+      m_peer_bit = false;
+}
+
+/* get_entropy()
+   quick estimate of the order 0 entropy of a message, in bits per byte, from an evenly spaced sample of its bytes
+*/
+float compress::get_entropy(const std::uint8_t* data, std::size_t size) noexcept
+{
+      std::uint16_t l_count[256];
+      std::size_t   l_step;
+      std::size_t   l_sample_size = 0;
+      float         l_sum = 0.0f;
+      if(size == 0) {
+          return 0.0f;
+      }
+      std::memset(l_count, 0, sizeof(l_count));
+      l_step = 1 + (size - 1) / entropy_sample_size;
+      for(std::size_t i_byte = 0; i_byte < size; i_byte += l_step) {
+          l_count[data[i_byte]]++;
+          l_sample_size++;
+      }
+      for(int i_value = 0; i_value < 256; i_value++) {
+          if(l_count[i_value]) {
+              l_sum += l_count[i_value] * std::log2(static_cast<float>(l_count[i_value]));
+          }
+      }
+      return std::log2(static_cast<float>(l_sample_size)) - l_sum / l_sample_size;
+}
+
+auto  compress::get_name() const noexcept -> const char*
+{
+      return "compress";
+}
+
+/* set_peer_support()
+   enable compression once the peer is known to run the stage as well (i.e. as advertised in its handshake); until then
+   messages pass through unchanged in both directions
+*/
+void  compress::set_peer_support(bool value) noexcept
+{
+      m_peer_bit = value;
+}
+
+bool  compress::get_peer_support() const noexcept
+{
+      return m_peer_bit;
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -0,0 +1,80 @@
+#ifndef emc_transport_compress_h
+#define emc_transport_compress_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/stage.h>
+#include <emc/transport.h>
+
+namespace emc {
+namespace transport {
+
+/* compress
+   Transcoding stage which compresses outbound messages and decompresses inbound ones; every message is framed with a
+   tag telling whether it is stored or compressed, so compression can be skipped for messages that would not gain from
+   it (too short, or too random), and always is while the peer is within ring_machine; both peers need to run the stage,
+   so it remains transparent until the upper layers have established that the peer supports it
+*/
+class compress: public emc::stage
+{
+  std::uint32_t   m_table[lz_table_size];
+  bool            m_peer_bit;
+
+  public:
+  static constexpr std::uint8_t frame_stored = 0u;
+  static constexpr std::uint8_t frame_packed = 1u;
+
+  /* size_min
+     messages shorter than this are always stored
+  */
+  static constexpr std::size_t size_min = 32u;
+
+  /* entropy_max
+     messages estimated to hold more bits of information per byte than this are stored without attempting to compress
+  */
+  static constexpr float  entropy_max = 7.0f;
+
+  protected:
+          bool    emi_is_enabled() const noexcept;
+  virtual int     emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_send(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual void    emc_raw_proto_down() noexcept override;
+  virtual void    emc_raw_drop() noexcept override;
+
+  public:
+          compress() noexcept;
+          compress(const compress&) noexcept = delete;
+          compress(compress&&) noexcept = delete;
+  virtual ~compress();
+
+  static  float   get_entropy(const std::uint8_t*, std::size_t) noexcept;
+  virtual const char* get_name() const noexcept override;
+          void    set_peer_support(bool) noexcept;
+          bool    get_peer_support() const noexcept;
+
+          compress& operator=(const compress&) noexcept = delete;
+          compress& operator=(compress&&) noexcept = delete;
+};
+
+/*namespace transport*/ }
+/*namespace emc*/ }
+#endif
@@ -0,0 +1,221 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace emc {
+namespace transport {
+
+/* crc32c_poly
+   Castagnoli polynomial, bit reflected
+*/
+static constexpr std::uint32_t crc32c_poly = 0x82f63b78u;
+
+/* crc32c_table_t
+   lookup tables for slicing-by-8: entry [k][b] is the crc of byte `b` followed by `k` zero bytes
+*/
+struct crc32c_table_t
+{
+  std::uint32_t value[8][256];
+};
+
+static constexpr crc32c_table_t crc32c_get_table() noexcept
+{
+      crc32c_table_t l_table{};
+      for(std::uint32_t i_byte = 0; i_byte < 256; i_byte++) {
+          std::uint32_t l_crc = i_byte;
+          for(int i_bit = 0; i_bit < 8; i_bit++) {
+              l_crc = (l_crc >> 1) ^ ((l_crc & 1u) ? crc32c_poly : 0u);
+          }
+          l_table.value[0][i_byte] = l_crc;
+      }
+      for(std::uint32_t i_byte = 0; i_byte < 256; i_byte++) {
+          for(int i_slice = 1; i_slice < 8; i_slice++) {
+              std::uint32_t l_crc = l_table.value[i_slice - 1][i_byte];
+              l_table.value[i_slice][i_byte] = (l_crc >> 8) ^ l_table.value[0][l_crc & 0xff];
+          }
+      }
+      return l_table;
+}
+
+static constexpr crc32c_table_t s_crc32c_table = crc32c_get_table();
+
+/* crc32c_update_scalar()
+   slicing-by-8: fold 8 bytes per step through 8 tables; works on the raw crc register (no pre/post inversion)
+*/
+static std::uint32_t crc32c_update_scalar(std::uint32_t crc, const std::uint8_t* src, std::size_t size) noexcept
+{
+      auto& l_table = s_crc32c_table.value;
+      while(size >= 8) {
+          std::uint32_t l_lo = crc ^ (src[0] | (src[1] << 8) | (src[2] << 16) | (static_cast<std::uint32_t>(src[3]) << 24));
+          crc = l_table[7][l_lo & 0xff] ^
+              l_table[6][(l_lo >> 8) & 0xff] ^
+              l_table[5][(l_lo >> 16) & 0xff] ^
+              l_table[4][l_lo >> 24] ^
+              l_table[3][src[4]] ^
+              l_table[2][src[5]] ^
+              l_table[1][src[6]] ^
+              l_table[0][src[7]];
+          src  += 8;
+          size -= 8;
+      }
+      while(size) {
+          crc = (crc >> 8) ^ l_table[0][(crc ^ *(src++)) & 0xff];
+          size--;
+      }
+      return crc;
+}
+
+/* crc32c_get_shift()
+   x^n mod P, bit reflected: the factor which moves a crc register `n` bits further down the message
+*/
+static std::uint32_t crc32c_get_shift(std::size_t n) noexcept
+{
+      std::uint32_t l_value = 0x80000000u;
+      while(n--) {
+          l_value = (l_value >> 1) ^ ((l_value & 1u) ? crc32c_poly : 0u);
+      }
+      return l_value;
+}
+
+#if defined(__x86_64__)
+/* crc32c_update_sse42()
+   hardware crc instruction, 8 bytes at a time
+*/
+__attribute__((target("sse4.2")))
+static std::uint32_t crc32c_update_sse42(std::uint32_t crc, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::uint64_t l_crc = crc;
+      std::uint64_t l_value;
+      while(size >= 8) {
+          std::memcpy(&l_value, src, sizeof(l_value));
+          l_crc = _mm_crc32_u64(l_crc, l_value);
+          src  += 8;
+          size -= 8;
+      }
+      while(size) {
+          l_crc = _mm_crc32_u8(l_crc, *(src++));
+          size--;
+      }
+      return l_crc;
+}
+
+/* crc32c_stripe_size
+   length of each of the three streams the pclmul kernel interleaves
+*/
+static constexpr std::size_t crc32c_stripe_size = 128;
+
+/* crc32c_stripe_shift_t
+   carryless multiplication constants that move the crc of a stream one, respectively two stripes further down:
+   x^(8 * stripe - 33) and x^(16 * stripe - 33) mod P; the product gains a factor x from the bit reflection and x^32
+   from the crc instruction reducing it
+*/
+struct crc32c_stripe_shift_t
+{
+  std::uint64_t k1;
+  std::uint64_t k2;
+};
+
+static const crc32c_stripe_shift_t s_crc32c_stripe_shift = {
+      crc32c_get_shift(crc32c_stripe_size * 8 - 33),
+      crc32c_get_shift(crc32c_stripe_size * 16 - 33)
+};
+
+/* crc32c_update_pclmul()
+   the crc instruction has a latency of 3 cycles but a throughput of 1: run it over three independent stripes at once
+   and merge the partial results with carryless multiplications
+*/
+__attribute__((target("sse4.2,pclmul")))
+static std::uint32_t crc32c_update_pclmul(std::uint32_t crc, const std::uint8_t* src, std::size_t size) noexcept
+{
+      std::uint64_t l_crc0 = crc;
+      while(size >= crc32c_stripe_size * 3) {
+          std::uint64_t l_crc1 = 0;
+          std::uint64_t l_crc2 = 0;
+          std::uint64_t l_value0;
+          std::uint64_t l_value1;
+          std::uint64_t l_value2;
+          for(std::size_t i_byte = 0; i_byte < crc32c_stripe_size; i_byte += 8) {
+              std::memcpy(&l_value0, src + i_byte, sizeof(l_value0));
+              std::memcpy(&l_value1, src + crc32c_stripe_size + i_byte, sizeof(l_value1));
+              std::memcpy(&l_value2, src + crc32c_stripe_size * 2 + i_byte, sizeof(l_value2));
+              l_crc0 = _mm_crc32_u64(l_crc0, l_value0);
+              l_crc1 = _mm_crc32_u64(l_crc1, l_value1);
+              l_crc2 = _mm_crc32_u64(l_crc2, l_value2);
+          }
+          __m128i l_k = _mm_set_epi64x(s_crc32c_stripe_shift.k1, s_crc32c_stripe_shift.k2);
+          __m128i l_p0 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(l_crc0), l_k, 0x00);
+          __m128i l_p1 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(l_crc1), l_k, 0x10);
+          l_crc0 = _mm_crc32_u64(0, _mm_cvtsi128_si64(l_p0)) ^
+              _mm_crc32_u64(0, _mm_cvtsi128_si64(l_p1)) ^
+              l_crc2;
+          src  += crc32c_stripe_size * 3;
+          size -= crc32c_stripe_size * 3;
+      }
+      return crc32c_update_sse42(l_crc0, src, size);
+}
+#endif
+
+/* crc32c_kernel_t
+   kernel picked once, at load time, from the features reported by cpuid
+*/
+struct crc32c_kernel_t
+{
+  std::uint32_t (*update)(std::uint32_t, const std::uint8_t*, std::size_t) noexcept;
+};
+
+static crc32c_kernel_t crc32c_get_kernel() noexcept
+{
+#if defined(__x86_64__)
+      __builtin_cpu_init();
+      if(__builtin_cpu_supports("sse4.2")) {
+          if(__builtin_cpu_supports("pclmul")) {
+              return {crc32c_update_pclmul};
+          }
+          return {crc32c_update_sse42};
+      }
+#endif
+      return {crc32c_update_scalar};
+}
+
+static const crc32c_kernel_t s_crc32c_kernel = crc32c_get_kernel();
+
+/* crc32c()
+   CRC-32C (Castagnoli) of `size` bytes, continuing from `crc`, which is 0 for a new message; i.e. the crc of
+   "123456789" is 0xe3069283
+*/
+std::uint32_t crc32c(std::uint32_t crc, const std::uint8_t* src, std::size_t size) noexcept
+{
+      return ~s_crc32c_kernel.update(~crc, src, size);
+}
+
+std::uint32_t crc32c(std::uint32_t crc, const char* src, std::size_t size) noexcept
+{
+      return crc32c(crc, reinterpret_cast<const std::uint8_t*>(src), size);
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -0,0 +1,247 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+/* lz_match_size_min
+   shortest match worth a sequence: anything shorter costs more than the literals it replaces
+*/
+static constexpr std::size_t lz_match_size_min = 4;
+
+/* lz_tail_size_min
+   the last bytes of the input are always emitted as literals, so that the match finder can read whole words anywhere
+   ahead of them
+*/
+static constexpr std::size_t lz_tail_size_min = 8;
+
+static inline std::uint32_t lz_load(const std::uint8_t* src) noexcept
+{
+      std::uint32_t l_value;
+      std::memcpy(&l_value, src, sizeof(l_value));
+      return l_value;
+}
+
+static inline unsigned int lz_hash(std::uint32_t value) noexcept
+{
+      return (value * 2654435761u) >> (32 - lz_hash_bits);
+}
+
+/* lz_put_size()
+   emit the part of a literal or match length that does not fit its nibble in the token
+*/
+static inline std::uint8_t* lz_put_size(std::uint8_t* dst, std::size_t size) noexcept
+{
+      while(size >= 255) {
+          *(dst++) = 255;
+          size -= 255;
+      }
+      *(dst++) = size;
+      return dst;
+}
+
+/* lz_put_sequence()
+   emit a sequence: a token holding the (truncated) literal and match lengths, the literals and, unless this is the last
+   sequence, the match offset; returns nullptr if the sequence does not fit into `dst_end`
+*/
+static std::uint8_t* lz_put_sequence(
+    std::uint8_t* dst, std::uint8_t* dst_end,
+    const std::uint8_t* literal_ptr, std::size_t literal_size,
+    std::size_t match_offset, std::size_t match_size
+) noexcept {
+      std::uint8_t* p_token = dst;
+      std::size_t   l_size_max = 1 + literal_size + literal_size / 255 + 1 + 2 + match_size / 255 + 1;
+      if(static_cast<std::size_t>(dst_end - dst) < l_size_max) {
+          return nullptr;
+      }
+      dst++;
+      if(literal_size >= 15) {
+          *p_token = 15 << 4;
+          dst = lz_put_size(dst, literal_size - 15);
+      } else
+          *p_token = literal_size << 4;
+      if(literal_size) {
+          std::memcpy(dst, literal_ptr, literal_size);
+          dst += literal_size;
+      }
+      if(match_size) {
+          match_size -= lz_match_size_min;
+          *(dst++) = match_offset & 0xff;
+          *(dst++) = match_offset >> 8;
+          if(match_size >= 15) {
+              *p_token |= 15;
+              dst = lz_put_size(dst, match_size - 15);
+          } else
+              *p_token |= match_size;
+      }
+      return dst;
+}
+
+/* lz_get_encode_size()
+   upper bound of the size of `size` bytes once compressed
+*/
+std::size_t lz_get_encode_size(std::size_t size) noexcept
+{
+      return size + size / 255 + 16;
+}
+
+/* lz_encode()
+   compress `size` bytes into an LZ4 style block: a series of sequences, each made of a run of literals followed by a
+   back reference of at least 4 bytes into the last lz_window_size bytes of the input;
+   `table` is the match finder state, lz_table_size entries, which need not be cleared between calls;
+   returns the size of the block or 0 if it does not fit into `dst_size` bytes
+*/
+std::size_t lz_encode(std::uint8_t* dst, std::size_t dst_size, const std::uint8_t* src, std::size_t size, std::uint32_t* table) noexcept
+{
+      std::uint8_t* p_dst = dst;
+      std::uint8_t* p_dst_end = dst + dst_size;
+      std::size_t   l_anchor = 0;
+      std::size_t   l_offset = 0;
+      if(size > lz_tail_size_min) {
+          std::size_t l_limit = size - lz_tail_size_min;
+          while(l_offset < l_limit) {
+              std::uint32_t l_value = lz_load(src + l_offset);
+              std::uint32_t l_hash = lz_hash(l_value);
+              std::size_t   l_match = table[l_hash];
+              table[l_hash] = l_offset;
+              // a table entry may be left over from a previous input: only trust it if it points behind the current
+              // position and the bytes actually match
+              if((l_match < l_offset) &&
+                  (l_offset - l_match <= lz_window_size) &&
+                  (lz_load(src + l_match) == l_value)) {
+                  std::size_t l_match_size = lz_match_size_min;
+                  while((l_offset + l_match_size < l_limit) &&
+                      (src[l_match + l_match_size] == src[l_offset + l_match_size])) {
+                      l_match_size++;
+                  }
+                  p_dst = lz_put_sequence(p_dst, p_dst_end, src + l_anchor, l_offset - l_anchor, l_offset - l_match, l_match_size);
+                  if(p_dst == nullptr) {
+                      return 0;
+                  }
+                  l_offset += l_match_size;
+                  l_anchor  = l_offset;
+              } else
+                  // skip ahead faster the longer there has been no match, so that incompressible input costs little
+                  l_offset += 1 + ((l_offset - l_anchor) >> 5);
+          }
+      }
+      p_dst = lz_put_sequence(p_dst, p_dst_end, src + l_anchor, size - l_anchor, 0, 0);
+      if(p_dst == nullptr) {
+          return 0;
+      }
+      return p_dst - dst;
+}
+
+/* lz_get_size()
+   read the extension of a literal or match length
+*/
+static inline bool lz_get_size(const std::uint8_t*& src, const std::uint8_t* src_end, std::size_t& size) noexcept
+{
+      std::uint8_t l_byte;
+      do {
+          if(src >= src_end) {
+              return false;
+          }
+          l_byte = *(src++);
+          size  += l_byte;
+      }
+      while(l_byte == 255);
+      return true;
+}
+
+/* lz_decode()
+   decompress a block produced by lz_encode() into at most `dst_size` bytes; decodes up to the first malformed sequence
+   (a length or offset running past either buffer) and stores the position of its token in `offset`, or `size` if the
+   whole block was valid;
+   returns the number of bytes written to `dst`
+*/
+std::size_t lz_decode(std::uint8_t* dst, std::size_t dst_size, const std::uint8_t* src, std::size_t size, std::size_t& offset) noexcept
+{
+      std::uint8_t*       p_dst = dst;
+      std::uint8_t*       p_dst_end = dst + dst_size;
+      const std::uint8_t* p_src = src;
+      const std::uint8_t* p_src_end = src + size;
+      while(p_src < p_src_end) {
+          const std::uint8_t* p_token = p_src;
+          std::size_t         l_literal_size = *p_src >> 4;
+          std::size_t         l_match_size = *p_src & 15;
+          std::size_t         l_match_offset;
+          p_src++;
+          if(l_literal_size == 15) {
+              if(lz_get_size(p_src, p_src_end, l_literal_size) == false) {
+                  offset = p_token - src;
+                  return p_dst - dst;
+              }
+          }
+          if((l_literal_size > static_cast<std::size_t>(p_src_end - p_src)) ||
+              (l_literal_size > static_cast<std::size_t>(p_dst_end - p_dst))) {
+              offset = p_token - src;
+              return p_dst - dst;
+          }
+          if(l_literal_size) {
+              std::memcpy(p_dst, p_src, l_literal_size);
+              p_dst += l_literal_size;
+              p_src += l_literal_size;
+          }
+          if(p_src == p_src_end) {
+              // last sequence: literals only
+              break;
+          }
+          if(p_src_end - p_src < 2) {
+              offset = p_token - src;
+              return p_dst - dst;
+          }
+          l_match_offset = p_src[0] | (p_src[1] << 8);
+          p_src += 2;
+          if(l_match_size == 15) {
+              if(lz_get_size(p_src, p_src_end, l_match_size) == false) {
+                  offset = p_token - src;
+                  return p_dst - dst;
+              }
+          }
+          l_match_size += lz_match_size_min;
+          if((l_match_offset == 0) ||
+              (l_match_offset > static_cast<std::size_t>(p_dst - dst)) ||
+              (l_match_size > static_cast<std::size_t>(p_dst_end - p_dst))) {
+              offset = p_token - src;
+              return p_dst - dst;
+          }
+          // the match may overlap the bytes it produces (i.e. a run), which rules out memcpy() for short offsets
+          const std::uint8_t* p_match = p_dst - l_match_offset;
+          if(l_match_offset >= l_match_size) {
+              std::memcpy(p_dst, p_match, l_match_size);
+              p_dst += l_match_size;
+          } else {
+              for(std::size_t i_byte = 0; i_byte < l_match_size; i_byte++) {
+                  *(p_dst++) = *(p_match++);
+              }
+          }
+      }
+      offset = size;
+      return p_dst - dst;
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -0,0 +1,569 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include "mux.h"
+#include <emc/error.h>
+#include <emc/protocol/emc/protocol.h>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+/* frame_size_max
+   largest packet frame: header, 0xfff bytes of payload, end of line
+*/
+static constexpr std::size_t frame_size_max = packet_head_size + 0xfff + 1;
+
+      mux::mux() noexcept:
+      stage(),
+      m_active_list{},
+      m_active_head(0),
+      m_active_count(0),
+      m_link_rate(0u),
+      m_link_budget(0u),
+      m_turn_bit(false),
+      m_peer_bit(false),
+      m_flush_bit(false)
+{
+      for(int i_channel = 0; i_channel < channel_count; i_channel++) {
+          channel_t& l_channel = m_channel_list[i_channel];
+          l_channel.queue_head = 0;
+          l_channel.queue_count = 0;
+          l_channel.queue_depth = queue_depth_default;
+          l_channel.deficit = 0u;
+          l_channel.credit = window_size_default;
+          l_channel.grant = 0u;
+          l_channel.window = window_size_default;
+          l_channel.idle_time = 0.0f;
+          l_channel.grant_bus = 0;
+          l_channel.active_bit = false;
+          l_channel.resync_bit = false;
+      }
+      reset_channel_stats();
+}
+
+      mux::~mux()
+{
+}
+
+/* emi_get_channel()
+   channel of an outbound message if it is a packet (README, section 3.7), chid_none if it is anything else; `load` is
+   set to the size of the packet payload
+*/
+int   mux::emi_get_channel(const std::uint8_t* data, std::size_t size, std::size_t& load) noexcept
+{
+      std::size_t l_load = 0u;
+      if(size < static_cast<std::size_t>(packet_head_size)) {
+          return chid_none;
+      }
+      if((data[0] < 0xff - chid_max) ||
+          (data[0] > 0xff - chid_min)) {
+          return chid_none;
+      }
+      for(int i_digit = 1; i_digit < packet_head_size; i_digit++) {
+          int l_digit = emc_get_hex(data[i_digit]);
+          if(l_digit < 0) {
+              return chid_none;
+          }
+          l_load = (l_load << 4) | l_digit;
+      }
+      if(l_load > size - packet_head_size) {
+          return chid_none;
+      }
+      load = l_load;
+      return 0xff - data[0];
+}
+
+/* emi_push()
+   copy a packet onto the queue of its channel, to be sent when it comes to its turn
+*/
+int   mux::emi_push(int bus, int chid, const std::uint8_t* data, std::size_t size, std::size_t load) noexcept
+{
+      channel_t&    l_channel = m_channel_list[chid];
+      std::uint8_t* l_copy_ptr;
+      if(l_channel.queue_count >= l_channel.queue_depth) {
+          l_channel.stats.drop_count++;
+          return err_fail;
+      }
+      l_copy_ptr = emc_get_block(size);
+      if(l_copy_ptr == nullptr) {
+          l_channel.stats.drop_count++;
+          return err_fail;
+      }
+      std::memcpy(l_copy_ptr, data, size);
+      packet_t& l_packet = l_channel.queue[(l_channel.queue_head + l_channel.queue_count) % queue_depth_max];
+      l_packet.data = l_copy_ptr;
+      l_packet.size = size;
+      l_packet.load = load;
+      l_packet.bus = bus;
+      l_channel.queue_count++;
+      if(l_channel.queue_count > l_channel.stats.queue_peak) {
+          l_channel.stats.queue_peak = l_channel.queue_count;
+      }
+      l_channel.stats.wait_count++;
+      if(l_channel.credit >= l_channel.queue[l_channel.queue_head].load) {
+          emi_activate(chid);
+      }
+      return err_okay;
+}
+
+/* emi_activate()
+   append a channel with queued packets and enough credit for the first of them to the round robin list
+*/
+void  mux::emi_activate(int chid) noexcept
+{
+      channel_t& l_channel = m_channel_list[chid];
+      if(l_channel.active_bit == false) {
+          m_active_list[(m_active_head + m_active_count) % channel_count] = chid;
+          m_active_count++;
+          l_channel.deficit = 0u;
+          l_channel.active_bit = true;
+      }
+}
+
+/* emi_spend()
+   take `size` bytes off the link budget, if there is a link rate set; fails if the budget does not cover them
+*/
+bool  mux::emi_spend(std::size_t size) noexcept
+{
+      if(m_link_rate > 0u) {
+          if(m_link_budget < size) {
+              return false;
+          }
+          m_link_budget -= size;
+      }
+      return true;
+}
+
+/* emi_flush()
+   deficit round robin over the active channels: on its turn, a channel is given another quantum and sends packets for
+   as long as both its deficit and its credit cover them; channels which run out of packets or credit leave the list,
+   and join it again once they get either
+*/
+void  mux::emi_flush() noexcept
+{
+      if(m_flush_bit) {
+          return;
+      }
+      m_flush_bit = true;
+      while(m_active_count > 0) {
+          int        l_chid = m_active_list[m_active_head];
+          channel_t& l_channel = m_channel_list[l_chid];
+          bool       l_stall_bit = false;
+          bool       l_busy_bit = false;
+          // the quantum is only given once per turn, a turn cut short by the link budget resumes on the next flush
+          if(m_turn_bit == false) {
+              l_channel.deficit += quantum_size;
+              m_turn_bit = true;
+          }
+          while(l_channel.queue_count > 0) {
+              packet_t& l_packet = l_channel.queue[l_channel.queue_head];
+              if(l_packet.load > l_channel.credit) {
+                  l_stall_bit = true;
+                  break;
+              }
+              if(l_packet.size > l_channel.deficit) {
+                  break;
+              }
+              if(emi_spend(l_packet.size) == false) {
+                  l_busy_bit = true;
+                  break;
+              }
+              if(stage::emc_raw_send(l_packet.bus, l_packet.data, l_packet.size) == err_okay) {
+                  l_channel.stats.send_count++;
+                  l_channel.stats.send_size += l_packet.load;
+                  l_channel.credit -= l_packet.load;
+              } else
+                  l_channel.stats.drop_count++;
+              l_channel.deficit -= l_packet.size;
+              emc_put_block(l_packet.data, l_packet.size);
+              l_channel.queue_head = (l_channel.queue_head + 1) % queue_depth_max;
+              l_channel.queue_count--;
+          }
+          if(l_busy_bit) {
+              break;
+          }
+          m_turn_bit = false;
+          m_active_head = (m_active_head + 1) % channel_count;
+          m_active_count--;
+          if((l_channel.queue_count == 0) ||
+              (l_stall_bit == true)) {
+              l_channel.deficit = 0u;
+              l_channel.active_bit = false;
+          } else
+              m_active_list[(m_active_head + m_active_count++) % channel_count] = l_chid;
+      }
+      m_flush_bit = false;
+}
+
+/* emi_grant()
+   hand `size` bytes of credit on channel `chid` back to the peer; a full grant (`set`) sets the credit of the peer to
+   `size` instead of adding to it
+*/
+int   mux::emi_grant(int bus, int chid, std::size_t size, bool set) noexcept
+{
+      constexpr char l_hex_chs[] = "0123456789abcdef";
+      std::uint8_t   l_digit_list[16];
+      int            l_digit_count = 0;
+      std::uint8_t*  l_line_ptr = emc_get_scratch(sizeof(grant_tag) + 4 + sizeof(l_digit_list) + 1);
+      std::size_t    l_line_size = 0;
+      if(l_line_ptr == nullptr) {
+          return err_fail;
+      }
+      std::memcpy(l_line_ptr, grant_tag, sizeof(grant_tag) - 1);
+      l_line_size = sizeof(grant_tag) - 1;
+      l_line_ptr[l_line_size++] = ' ';
+      l_line_ptr[l_line_size++] = l_hex_chs[(chid >> 4) & 15];
+      l_line_ptr[l_line_size++] = l_hex_chs[chid & 15];
+      l_line_ptr[l_line_size++] = ' ';
+      if(set) {
+          l_line_ptr[l_line_size++] = '=';
+      }
+      do {
+          l_digit_list[l_digit_count++] = l_hex_chs[size & 15];
+          size >>= 4;
+      }
+      while(size);
+      while(l_digit_count > 0) {
+          l_line_ptr[l_line_size++] = l_digit_list[--l_digit_count];
+      }
+      l_line_ptr[l_line_size++] = '\n';
+      return stage::emc_raw_send(bus, l_line_ptr, l_line_size);
+}
+
+/* emi_recv_grant()
+   take in a credit grant from the peer: `]k CHID SIZE`, or `]k CHID =SIZE` for a full grant, both in hex
+*/
+int   mux::emi_recv_grant(const std::uint8_t* data, std::size_t size) noexcept
+{
+      std::size_t l_value[2] = {0u, 0u};
+      std::size_t l_offset = sizeof(grant_tag) - 1;
+      bool        l_set_bit = false;
+      for(int i_field = 0; i_field < 2; i_field++) {
+          int l_digit_count = 0;
+          while((l_offset < size) &&
+              ((data[l_offset] == ' ') || (data[l_offset] == '\t'))) {
+              l_offset++;
+          }
+          if((i_field == 1) &&
+              (l_offset < size) &&
+              (data[l_offset] == '=')) {
+              l_set_bit = true;
+              l_offset++;
+          }
+          while(l_offset < size) {
+              int l_digit = emc_get_hex(data[l_offset]);
+              if(l_digit < 0) {
+                  break;
+              }
+              if(l_digit_count == 8) {
+                  return err_parse;
+              }
+              l_value[i_field] = (l_value[i_field] << 4) | l_digit;
+              l_digit_count++;
+              l_offset++;
+          }
+          if(l_digit_count == 0) {
+              return err_parse;
+          }
+      }
+      if((l_value[0] < chid_min) ||
+          (l_value[0] > chid_max)) {
+          return err_parse;
+      }
+      channel_t& l_channel = m_channel_list[l_value[0]];
+      if(l_set_bit) {
+          l_channel.credit = l_value[1];
+      } else
+          l_channel.credit += l_value[1];
+      if(l_channel.queue_count > 0) {
+          if(l_channel.credit >= l_channel.queue[l_channel.queue_head].load) {
+              emi_activate(l_value[0]);
+              emi_flush();
+          }
+      }
+      return err_okay;
+}
+
+/* emi_clear()
+   drop all the queued packets and start over with the initial credit
+*/
+void  mux::emi_clear() noexcept
+{
+      for(int i_channel = 0; i_channel < channel_count; i_channel++) {
+          channel_t& l_channel = m_channel_list[i_channel];
+          while(l_channel.queue_count > 0) {
+              packet_t& l_packet = l_channel.queue[l_channel.queue_head];
+              emc_put_block(l_packet.data, l_packet.size);
+              l_channel.queue_head = (l_channel.queue_head + 1) % queue_depth_max;
+              l_channel.queue_count--;
+              l_channel.stats.drop_count++;
+          }
+          l_channel.queue_head = 0;
+          l_channel.deficit = 0u;
+          l_channel.credit = window_size_default;
+          l_channel.grant = 0u;
+          l_channel.window = window_size_default;
+          l_channel.idle_time = 0.0f;
+          l_channel.active_bit = false;
+          l_channel.resync_bit = false;
+      }
+      m_active_head = 0;
+      m_active_count = 0;
+      m_turn_bit = false;
+}
+
+/* emc_raw_recv()
+   consume the credit grants of the peer; count the packets delivered on each channel, granting credit back to the
+   peer as they go up the pipeline, and arm the full grant sent once the channel goes quiet (see emc_raw_sync())
+*/
+int   mux::emc_raw_recv(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(m_peer_bit) {
+          std::size_t l_load;
+          int         l_chid = emi_get_channel(data, size, l_load);
+          if(l_chid != chid_none) {
+              channel_t& l_channel = m_channel_list[l_chid];
+              int        l_result = stage::emc_raw_recv(bus, data, size);
+              // the payload is off the link either way, so the credit is returned even if the upper stages refused it
+              l_channel.stats.recv_count++;
+              l_channel.stats.recv_size += l_load;
+              l_channel.grant += l_load;
+              l_channel.idle_time = 0.0f;
+              l_channel.grant_bus = bus;
+              l_channel.resync_bit = true;
+              if(l_channel.grant >= grant_size_min) {
+                  if(emi_grant(bus, l_chid, l_channel.grant) == err_okay) {
+                      l_channel.grant = 0u;
+                  }
+              }
+              return l_result;
+          } else
+          if((size >= sizeof(grant_tag) - 1) &&
+              (std::memcmp(data, grant_tag, sizeof(grant_tag) - 1) == 0)) {
+              return emi_recv_grant(data, size);
+          }
+      }
+      return stage::emc_raw_recv(bus, data, size);
+}
+
+/* emc_raw_send()
+   pass lines on as they are; pass packets on straight away if nothing is queued and the channel has credit for them,
+   otherwise queue them up for the scheduler
+*/
+int   mux::emc_raw_send(int bus, std::uint8_t* data, std::size_t size) noexcept
+{
+      if(m_peer_bit) {
+          std::size_t l_load;
+          int         l_chid = emi_get_channel(data, size, l_load);
+          if(l_chid != chid_none) {
+              channel_t& l_channel = m_channel_list[l_chid];
+              int        l_result;
+              if((m_active_count == 0) &&
+                  (l_channel.queue_count == 0) &&
+                  (l_channel.credit >= l_load) &&
+                  (emi_spend(size) == true)) {
+                  l_result = stage::emc_raw_send(bus, data, size);
+                  if(l_result == err_okay) {
+                      l_channel.stats.send_count++;
+                      l_channel.stats.send_size += l_load;
+                      l_channel.credit -= l_load;
+                  } else
+                      l_channel.stats.drop_count++;
+                  return l_result;
+              }
+              l_result = emi_push(bus, l_chid, data, size, l_load);
+              emi_flush();
+              return l_result;
+          }
+          // lines go out regardless, but still take their share of the link
+          if(emi_spend(size) == false) {
+              m_link_budget = 0u;
+          }
+      }
+      return stage::emc_raw_send(bus, data, size);
+}
+
+/* emc_raw_proto_down()
+   drop the packets still queued and reset the credit of every channel: a new peer starts with a full window
+*/
+void  mux::emc_raw_proto_down() noexcept
+{
+      emi_clear();
+      m_peer_bit = false;
+}
+
+void  mux::emc_raw_drop() noexcept
+{
+      emi_clear();
+      m_peer_bit = false;
+}
+
+/* emc_raw_detach()
+   queued packets are held in blocks of the owner reactor, give them back while still attached
+*/
+void  mux::emc_raw_detach(reactor*) noexcept
+{
+      emi_clear();
+}
+
+/* emc_raw_sync()
+   refill the link budget and carry on with the queued packets; send a full grant on the channels which went quiet
+   since packets last arrived on them: with nothing left in flight, the peer is meant to hold the whole window, and
+   setting it outright restores the credit of the packets which were lost on the way rather than delivered; a packet
+   still in flight when the grant goes out is credited twice, until the next full grant
+*/
+void  mux::emc_raw_sync(float dt) noexcept
+{
+      if(m_peer_bit) {
+          for(int i_channel = chid_min; i_channel <= chid_max; i_channel++) {
+              channel_t& l_channel = m_channel_list[i_channel];
+              if(l_channel.resync_bit) {
+                  l_channel.idle_time += dt;
+                  if(l_channel.idle_time >= resync_time) {
+                      if(emi_grant(l_channel.grant_bus, i_channel, l_channel.window, true) == err_okay) {
+                          l_channel.grant = 0u;
+                          l_channel.resync_bit = false;
+                      }
+                  }
+              }
+          }
+      }
+      if(m_link_rate > 0u) {
+          std::size_t l_budget_max = m_link_rate * link_burst_time;
+          if(l_budget_max < frame_size_max) {
+              l_budget_max = frame_size_max;
+          }
+          m_link_budget += m_link_rate * dt;
+          if(m_link_budget > l_budget_max) {
+              m_link_budget = l_budget_max;
+          }
+      }
+      if(m_active_count > 0) {
+          emi_flush();
+      }
+}
+
+auto  mux::get_name() const noexcept -> const char*
+{
+      return "mux";
+}
+
+/* set_peer_support()
+   switch credit accounting and scheduling on or off; either way the channels restart from an empty queue and a full
+   window, since credit granted under one setting means nothing under the other
+*/
+void  mux::set_peer_support(bool value) noexcept
+{
+      if(m_peer_bit != value) {
+          emi_clear();
+          m_peer_bit = value;
+      }
+}
+
+bool  mux::get_peer_support() const noexcept
+{
+      return m_peer_bit;
+}
+
+/* set_channel_depth()
+   set how many packets the channel may queue; lowering the depth does not drop the packets already queued
+*/
+bool  mux::set_channel_depth(int chid, int depth) noexcept
+{
+      if((chid < chid_min) ||
+          (chid > chid_max)) {
+          return false;
+      }
+      if((depth < 1) ||
+          (depth > queue_depth_max)) {
+          return false;
+      }
+      m_channel_list[chid].queue_depth = depth;
+      return true;
+}
+
+int   mux::get_channel_depth(int chid) const noexcept
+{
+      if((chid < chid_min) ||
+          (chid > chid_max)) {
+          return 0;
+      }
+      return m_channel_list[chid].queue_depth;
+}
+
+/* set_link_rate()
+   pace the packets sent to the given rate, in bytes per second, 0 to send them as fast as credit allows; the budget is
+   refilled from sync()
+*/
+void  mux::set_link_rate(std::size_t rate) noexcept
+{
+      m_link_rate = rate;
+      m_link_budget = 0u;
+}
+
+std::size_t mux::get_link_rate() const noexcept
+{
+      return m_link_rate;
+}
+
+/* grant()
+   grant the peer extra credit on a channel, on top of the credit returned as packets are delivered; for receivers
+   which can take in more than window_size_default bytes at a time; the extra credit is kept in the full grants too
+*/
+int   mux::grant(int bus, int chid, std::size_t size) noexcept
+{
+      if((chid < chid_min) ||
+          (chid > chid_max)) {
+          return err_fail;
+      }
+      if(m_peer_bit == false) {
+          return err_fail;
+      }
+      if(emi_grant(bus, chid, size) != err_okay) {
+          return err_fail;
+      }
+      m_channel_list[chid].window += size;
+      return err_okay;
+}
+
+bool  mux::get_channel_stats(int chid, channel_stats_t& stats) const noexcept
+{
+      if((chid < chid_min) ||
+          (chid > chid_max)) {
+          return false;
+      }
+      const channel_t& l_channel = m_channel_list[chid];
+      stats = l_channel.stats;
+      stats.queue_depth = l_channel.queue_count;
+      stats.credit = l_channel.credit;
+      return true;
+}
+
+void  mux::reset_channel_stats() noexcept
+{
+      for(int i_channel = 0; i_channel < channel_count; i_channel++) {
+          std::memset(std::addressof(m_channel_list[i_channel].stats), 0, sizeof(channel_stats_t));
+      }
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -0,0 +1,171 @@
+#ifndef emc_transport_mux_h
+#define emc_transport_mux_h
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/stage.h>
+
+namespace emc {
+namespace transport {
+
+/* mux
+   Channel multiplexer stage: keeps the channel packets (chid_min..chid_max) sharing the link from starving one another
+   and from overrunning the receiver;
+   - credits: each channel may only have window_size_default bytes of payload in flight; the receiving end grants the
+     credit back (with a `]k CHID SIZE` line) as the packets are delivered to its upper stages; credit for packets lost
+     below the stage (checksum, cipher or framing failures) is never granted back, so once a channel goes quiet the
+     receiving end also sends a full grant (`]k CHID =SIZE`), which sets the credit of the sender outright;
+   - scheduling: packets that can not go out straight away are queued per channel and sent in deficit round robin order,
+     each backlogged channel being given a quantum of quantum_size bytes per round, so a channel with a deep backlog
+     (e.g. a firmware upload) only delays the packets of the others (e.g. telemetry) by a round at most;
+   - link rate: optionally, the stage paces the packets it sends to the rate of the link (e.g. a serial line), so the
+     backlog builds up in its queues, where it can be scheduled, rather than in the buffers of the lower layers;
+   - lines (requests, responses) are never held back.
+   Grants are only understood by a peer running the stage too, so until set_peer_support() is called packets go out
+   unscheduled and without credit accounting.
+*/
+class mux: public emc::stage
+{
+  public:
+  static constexpr int  channel_count = chid_max + 1;
+
+  /* queue_depth_*
+     number of packets each channel may queue while waiting for its turn or for credit
+  */
+  static constexpr int  queue_depth_max = 32;
+  static constexpr int  queue_depth_default = 8;
+
+  /* window_size_default
+     initial credit of each channel, in bytes of payload
+  */
+  static constexpr std::size_t window_size_default = 16384u;
+
+  /* grant_size_min
+     the receiving end holds back granting credit until at least this much payload was delivered on a channel
+  */
+  static constexpr std::size_t grant_size_min = window_size_default / 4u;
+
+  /* resync_time
+     the receiving end sends a full grant on a channel once no packet arrived on it for this long, in seconds
+  */
+  static constexpr float  resync_time = 1.0f;
+
+  /* quantum_size
+     bytes a backlogged channel is allowed to send per round
+  */
+  static constexpr std::size_t quantum_size = packet_size_max;
+
+  /* link_burst_time
+     with a link rate set, how much unused budget may be saved up, in seconds worth of link time
+  */
+  static constexpr float  link_burst_time = 0.05f;
+
+  static constexpr char grant_tag[] = "]k";
+
+  struct channel_stats_t {
+    std::uint64_t send_count;
+    std::uint64_t send_size;
+    std::uint64_t recv_count;
+    std::uint64_t recv_size;
+    std::uint64_t drop_count;
+    std::uint64_t wait_count;     // packets which had to be queued
+    int           queue_depth;
+    int           queue_peak;
+    std::size_t   credit;
+  };
+
+  private:
+  struct packet_t {
+    std::uint8_t* data;
+    std::size_t   size;
+    std::size_t   load;
+    int           bus;
+  };
+
+  struct channel_t {
+    packet_t      queue[queue_depth_max];
+    int           queue_head;
+    int           queue_count;
+    int           queue_depth;
+    std::size_t   deficit;
+    std::size_t   credit;
+    std::size_t   grant;
+    std::size_t   window;       // credit the peer holds on this channel with nothing in flight
+    float         idle_time;
+    int           grant_bus;
+    bool          active_bit;
+    bool          resync_bit;
+    channel_stats_t stats;
+  };
+
+  channel_t       m_channel_list[channel_count];
+  std::uint8_t    m_active_list[channel_count];
+  int             m_active_head;
+  int             m_active_count;
+  std::size_t     m_link_rate;
+  std::size_t     m_link_budget;
+  bool            m_turn_bit;
+  bool            m_peer_bit;
+  bool            m_flush_bit;
+
+  private:
+  static  int     emi_get_channel(const std::uint8_t*, std::size_t, std::size_t&) noexcept;
+          int     emi_push(int, int, const std::uint8_t*, std::size_t, std::size_t) noexcept;
+          void    emi_activate(int) noexcept;
+          bool    emi_spend(std::size_t) noexcept;
+          void    emi_flush() noexcept;
+          int     emi_grant(int, int, std::size_t, bool = false) noexcept;
+          int     emi_recv_grant(const std::uint8_t*, std::size_t) noexcept;
+          void    emi_clear() noexcept;
+
+  protected:
+  virtual int     emc_raw_recv(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual int     emc_raw_send(int, std::uint8_t*, std::size_t) noexcept override;
+  virtual void    emc_raw_proto_down() noexcept override;
+  virtual void    emc_raw_drop() noexcept override;
+  virtual void    emc_raw_detach(reactor*) noexcept override;
+  virtual void    emc_raw_sync(float) noexcept override;
+
+  public:
+          mux() noexcept;
+          mux(const mux&) noexcept = delete;
+          mux(mux&&) noexcept = delete;
+  virtual ~mux();
+
+  virtual const char* get_name() const noexcept override;
+          void    set_peer_support(bool) noexcept;
+          bool    get_peer_support() const noexcept;
+          bool    set_channel_depth(int, int) noexcept;
+          int     get_channel_depth(int) const noexcept;
+          void    set_link_rate(std::size_t) noexcept;
+          std::size_t get_link_rate() const noexcept;
+          int     grant(int, int, std::size_t) noexcept;
+          bool    get_channel_stats(int, channel_stats_t&) const noexcept;
+          void    reset_channel_stats() noexcept;
+
+          mux&    operator=(const mux&) noexcept = delete;
+          mux&    operator=(mux&&) noexcept = delete;
+};
+
+/*namespace transport*/ }
+/*namespace emc*/ }
+#endif
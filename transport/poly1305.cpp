@@ -0,0 +1,219 @@
+/**
+    Copyright (c) 2025, wicked systems
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following
+    conditions are met:
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+      disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of wicked systems nor the names of its contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+    INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#include <emc.h>
+#include <emc/transport.h>
+#include <cstring>
+
+namespace emc {
+namespace transport {
+
+/* poly1305_mask_44, poly1305_mask_42
+   the 130 bit accumulator and key are held in three limbs of 44, 44 and 42 bits, so that limb products fit into 128 bits
+   with room for the carries
+*/
+static constexpr std::uint64_t poly1305_mask_44 = 0xfffffffffffull;
+static constexpr std::uint64_t poly1305_mask_42 = 0x3ffffffffffull;
+
+static inline std::uint64_t poly1305_load(const std::uint8_t* src) noexcept
+{
+      std::uint64_t l_value = 0;
+      for(int i_byte = 7; i_byte >= 0; i_byte--) {
+          l_value = (l_value << 8) | src[i_byte];
+      }
+      return l_value;
+}
+
+static inline void poly1305_store(std::uint8_t* dst, std::uint64_t value) noexcept
+{
+      for(int i_byte = 0; i_byte < 8; i_byte++) {
+          dst[i_byte] = value & 0xff;
+          value >>= 8;
+      }
+}
+
+      poly1305::poly1305() noexcept:
+      m_r(),
+      m_h(),
+      m_pad(),
+      m_cache(),
+      m_cache_size(0)
+{
+}
+
+      poly1305::poly1305(const std::uint8_t* key) noexcept:
+      poly1305()
+{
+      reset(key);
+}
+
+      poly1305::~poly1305()
+{
+      std::memset(m_r, 0, sizeof(m_r));
+      std::memset(m_pad, 0, sizeof(m_pad));
+}
+
+/* emi_update()
+   absorb whole 16 byte blocks: h = (h + block) * r mod 2^130 - 5; `hibit` is the bit appended after a full block, left
+   out of the padded last block
+*/
+void  poly1305::emi_update(const std::uint8_t* src, std::size_t size, std::uint64_t hibit) noexcept
+{
+      using u128 = unsigned __int128;
+      std::uint64_t r0 = m_r[0];
+      std::uint64_t r1 = m_r[1];
+      std::uint64_t r2 = m_r[2];
+      std::uint64_t s1 = r1 * (5 << 2);
+      std::uint64_t s2 = r2 * (5 << 2);
+      std::uint64_t h0 = m_h[0];
+      std::uint64_t h1 = m_h[1];
+      std::uint64_t h2 = m_h[2];
+      while(size >= block_size) {
+          std::uint64_t t0 = poly1305_load(src);
+          std::uint64_t t1 = poly1305_load(src + 8);
+          std::uint64_t c;
+          h0 += t0 & poly1305_mask_44;
+          h1 += ((t0 >> 44) | (t1 << 20)) & poly1305_mask_44;
+          h2 += ((t1 >> 24) & poly1305_mask_42) | hibit;
+          u128 d0 = static_cast<u128>(h0) * r0 + static_cast<u128>(h1) * s2 + static_cast<u128>(h2) * s1;
+          u128 d1 = static_cast<u128>(h0) * r1 + static_cast<u128>(h1) * r0 + static_cast<u128>(h2) * s2;
+          u128 d2 = static_cast<u128>(h0) * r2 + static_cast<u128>(h1) * r1 + static_cast<u128>(h2) * r0;
+          c  = static_cast<std::uint64_t>(d0 >> 44); h0 = static_cast<std::uint64_t>(d0) & poly1305_mask_44;
+          d1 += c;
+          c  = static_cast<std::uint64_t>(d1 >> 44); h1 = static_cast<std::uint64_t>(d1) & poly1305_mask_44;
+          d2 += c;
+          c  = static_cast<std::uint64_t>(d2 >> 42); h2 = static_cast<std::uint64_t>(d2) & poly1305_mask_42;
+          h0 += c * 5;
+          c  = h0 >> 44; h0 &= poly1305_mask_44;
+          h1 += c;
+          src  += block_size;
+          size -= block_size;
+      }
+      m_h[0] = h0;
+      m_h[1] = h1;
+      m_h[2] = h2;
+}
+
+/* reset()
+   start a new message with a one time `key`: the clamped r and the pad s, 16 bytes each
+*/
+void  poly1305::reset(const std::uint8_t* key) noexcept
+{
+      std::uint64_t t0 = poly1305_load(key);
+      std::uint64_t t1 = poly1305_load(key + 8);
+      m_r[0] = t0 & 0xffc0fffffffull;
+      m_r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffull;
+      m_r[2] = (t1 >> 24) & 0x00ffffffc0full;
+      m_h[0] = 0;
+      m_h[1] = 0;
+      m_h[2] = 0;
+      m_pad[0] = poly1305_load(key + 16);
+      m_pad[1] = poly1305_load(key + 24);
+      m_cache_size = 0;
+}
+
+void  poly1305::update(const std::uint8_t* src, std::size_t size) noexcept
+{
+      if(m_cache_size) {
+          std::size_t l_size = block_size - m_cache_size;
+          if(l_size > size) {
+              l_size = size;
+          }
+          std::memcpy(m_cache + m_cache_size, src, l_size);
+          m_cache_size += l_size;
+          src  += l_size;
+          size -= l_size;
+          if(m_cache_size < block_size) {
+              return;
+          }
+          emi_update(m_cache, block_size, 1ull << 40);
+          m_cache_size = 0;
+      }
+      if(size >= block_size) {
+          std::size_t l_size = size & ~(block_size - 1);
+          emi_update(src, l_size, 1ull << 40);
+          src  += l_size;
+          size -= l_size;
+      }
+      if(size) {
+          std::memcpy(m_cache, src, size);
+          m_cache_size = size;
+      }
+}
+
+/* finish()
+   absorb the last, partial block, fully reduce the accumulator and add the pad; writes the 16 byte tag
+*/
+void  poly1305::finish(std::uint8_t* tag) noexcept
+{
+      std::uint64_t h0, h1, h2, c;
+      std::uint64_t g0, g1, g2;
+      std::uint64_t t0, t1;
+      if(m_cache_size) {
+          m_cache[m_cache_size] = 1;
+          std::memset(m_cache + m_cache_size + 1, 0, block_size - m_cache_size - 1);
+          emi_update(m_cache, block_size, 0);
+          m_cache_size = 0;
+      }
+      h0 = m_h[0];
+      h1 = m_h[1];
+      h2 = m_h[2];
+      c = h1 >> 44; h1 &= poly1305_mask_44;
+      h2 += c;      c = h2 >> 42; h2 &= poly1305_mask_42;
+      h0 += c * 5;  c = h0 >> 44; h0 &= poly1305_mask_44;
+      h1 += c;      c = h1 >> 44; h1 &= poly1305_mask_44;
+      h2 += c;      c = h2 >> 42; h2 &= poly1305_mask_42;
+      h0 += c * 5;  c = h0 >> 44; h0 &= poly1305_mask_44;
+      h1 += c;
+      // h - p, picked in constant time if h >= p
+      g0 = h0 + 5;  c = g0 >> 44; g0 &= poly1305_mask_44;
+      g1 = h1 + c;  c = g1 >> 44; g1 &= poly1305_mask_44;
+      g2 = h2 + c - (1ull << 42);
+      c = (g2 >> 63) - 1;
+      g0 &= c;
+      g1 &= c;
+      g2 &= c;
+      c = ~c;
+      h0 = (h0 & c) | g0;
+      h1 = (h1 & c) | g1;
+      h2 = (h2 & c) | g2;
+      // h + s mod 2^128
+      t0 = m_pad[0];
+      t1 = m_pad[1];
+      h0 += t0 & poly1305_mask_44; c = h0 >> 44; h0 &= poly1305_mask_44;
+      h1 += (((t0 >> 44) | (t1 << 20)) & poly1305_mask_44) + c; c = h1 >> 44; h1 &= poly1305_mask_44;
+      h2 += ((t1 >> 24) & poly1305_mask_42) + c; h2 &= poly1305_mask_42;
+      poly1305_store(tag, h0 | (h1 << 44));
+      poly1305_store(tag + 8, (h1 >> 20) | (h2 << 24));
+}
+
+/* poly1305_mac()
+   one shot RFC 8439 Poly1305 of `size` bytes with a one time `key`
+*/
+void  poly1305_mac(std::uint8_t* tag, const std::uint8_t* src, std::size_t size, const std::uint8_t* key) noexcept
+{
+      poly1305 l_mac(key);
+      l_mac.update(src, size);
+      l_mac.finish(tag);
+}
+
+/*namespace transport*/ }
+/*namespace emc*/ }
@@ -20,7 +20,10 @@
     EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
 #include "uart.h"
+#include "config.h"
 #include <emc/error.h>
+#include <emc/transport.h>
+#include <cstring>
 
 namespace emc {
 namespace transport {
@@ -30,12 +33,17 @@ namespace transport {
       m_format(codec_format_none),
       m_cache_ptr(nullptr),
       m_cache_size(0),
-      m_ready_bit(false)
+      m_send_ptr(nullptr),
+      m_send_size(0),
+      m_ready_bit(false),
+      m_base16_decoder(),
+      m_base64_decoder()
 {
 }
 
       uart::~uart()
 {
+      emi_send_dispose();
       emi_cache_dispose();
 }
 
@@ -65,38 +73,141 @@ void  uart::emi_cache_dispose() noexcept
       m_cache_size = 0;
 }
 
+/* emi_get_format()
+   format outbound packets are actually transcoded in: none while the peer is within ring_machine, where the data never
+   goes through an actual uart and the packets are passed on as they are, behind a packet_raw marker
+*/
+int   uart::emi_get_format() const noexcept
+{
+      if(has_ring(ring_machine)) {
+          return codec_format_none;
+      }
+      return m_format;
+}
+
+/* emi_get_chunk_size()
+   how many bytes of an outbound packet fit into a single mtu sized packet once encoded in the given format; base64
+   chunks are kept to whole groups so that every chunk is padded only if it is the last one
+*/
+int   uart::emi_get_chunk_size(int format) const noexcept
+{
+      if(format == codec_format_base16) {
+          return mtu_size / 2;
+      } else
+      if(format == codec_format_base64) {
+          return mtu_size / 4 * 3;
+      } else
+      if(format == codec_format_cobs) {
+          return mtu_size - mtu_size / 254 - 1;
+      }
+      return mtu_size;
+}
+
+/* emi_send_reserve()
+   preallocate the buffer outbound packets are encoded into: a single chunk in the configured format, or a marked raw
+   chunk, so that the send path itself never has to allocate; with no format configured packets are passed on in place
+   and need none
+*/
+bool  uart::emi_send_reserve() noexcept
+{
+      void* l_send_ptr;
+      int   l_send_size = 0;
+      if(m_format == codec_format_base16) {
+          l_send_size = base16_encoder::get_size_max(emi_get_chunk_size(m_format));
+      } else
+      if(m_format == codec_format_base64) {
+          l_send_size = base64_encoder::get_size_max(emi_get_chunk_size(m_format));
+      } else
+      if(m_format == codec_format_cobs) {
+          l_send_size = cobs_get_encode_size(emi_get_chunk_size(m_format));
+      }
+      if(m_format != codec_format_none) {
+          if(l_send_size < mtu_size) {
+              l_send_size = mtu_size;
+          }
+      }
+      if(l_send_size > m_send_size) {
+          l_send_ptr = realloc(m_send_ptr, l_send_size);
+          if(l_send_ptr != nullptr) {
+              m_send_ptr = reinterpret_cast<std::uint8_t*>(l_send_ptr);
+              m_send_size = l_send_size;
+              return true;
+          }
+          return false;
+      }
+      return true;
+}
+
+void  uart::emi_send_dispose() noexcept
+{
+      if(m_send_ptr != nullptr) {
+          free(m_send_ptr);
+          m_send_ptr = nullptr;
+      }
+      m_send_size = 0;
+}
+
 bool  uart::emc_std_resume(emc::gateway*) noexcept
 {
-      return emi_cache_reserve(global::cache_large_max);
+      if(emi_cache_reserve(global::cache_large_max)) {
+          if(emi_send_reserve()) {
+              return true;
+          }
+          emi_cache_dispose();
+      }
+      return false;
 }
 
 int   uart::emc_std_process_packet(int channel, int size, std::uint8_t* data) noexcept
 {
       if(size > 0) {
+          int           l_format = m_format;
           std::uint8_t* l_forward_data = data;
           int           l_forward_size = size;
-          if(m_format == codec_format_base16) {
-              l_forward_data = m_cache_ptr;
-              l_forward_size = size / 2;
+          if(l_format != codec_format_none) {
+              if(data[0] == packet_raw) {
+                  return emc::emcstage::emc_std_process_packet(channel, size - 1, data + 1);
+              }
+          }
+          if(l_format == codec_format_base16) {
+              l_forward_size = base16_decoder::get_size_max(size);
               if(emi_cache_reserve(l_forward_size)) {
-                  base16_decode(l_forward_data, data, size);
-                  return emc::err_okay;
+                  l_forward_data = m_cache_ptr;
+                  m_base16_decoder.reset();
+                  l_forward_size  = m_base16_decoder.update(l_forward_data, data, size);
+                  l_forward_size += m_base16_decoder.finish(l_forward_data + l_forward_size);
+                  if(m_base16_decoder.has_error()) {
+                      // malformed packet (i.e. line noise), drop it here rather than passing garbage downstream
+                      return emc::err_parse;
+                  }
               } else
                   return emc::err_fail;
           } else
-          if(m_format == codec_format_base64) {
-              if(size < std::numeric_limits<int>::max() / 6) {
-                  l_forward_data = m_cache_ptr;
-                  l_forward_size = get_round_value(size * 6 / 8, 8);
+          if(l_format == codec_format_base64) {
+              if(size < std::numeric_limits<int>::max() / 4) {
+                  l_forward_size = base64_decoder::get_size_max(size);
                   if(emi_cache_reserve(l_forward_size)) {
-                      base64_decode(l_forward_data, data, size);
-                      return emc::err_okay;
+                      l_forward_data = m_cache_ptr;
+                      m_base64_decoder.reset();
+                      l_forward_size  = m_base64_decoder.update(l_forward_data, data, size);
+                      l_forward_size += m_base64_decoder.finish(l_forward_data + l_forward_size);
                   } else
                       return emc::err_fail;
               } else
                   return emc::err_fail;
           } else
-          if(m_format != codec_format_none) {
+          if(l_format == codec_format_cobs) {
+              std::size_t l_error_offset;
+              if(emi_cache_reserve(size)) {
+                  l_forward_data = m_cache_ptr;
+                  l_forward_size = cobs_decode(l_forward_data, data, size, l_error_offset, cobs_delimiter);
+                  if(l_error_offset != static_cast<std::size_t>(size)) {
+                      return emc::err_parse;
+                  }
+              } else
+                  return emc::err_fail;
+          } else
+          if(l_format != codec_format_none) {
               return emc::err_fail;
           }
           return emc::emcstage::emc_std_process_packet(channel, l_forward_size, l_forward_data);
@@ -104,17 +215,62 @@ int   uart::emc_std_process_packet(int channel, int size, std::uint8_t* data) no
       return emc::err_okay;
 }
 
+/* emc_std_return_packet()
+   encode an outbound packet in the current format and pass it on in mtu sized chunks; the encoded and the marked raw
+   chunks are written into the send buffer reserved on resume, unmarked raw chunks are passed on in place
+*/
 int   uart::emc_std_return_packet(int channel, int size, std::uint8_t* data) noexcept
 {
-      if(m_cache_ptr != nullptr) {
-          return emc::err_fail;
+      if(size > 0) {
+          int  l_format = emi_get_format();
+          int  l_chunk_size = emi_get_chunk_size(l_format);
+          bool l_mark_bit = (l_format == codec_format_none) && (m_format != codec_format_none);
+          int  l_result;
+          if(m_format != codec_format_none) {
+              if(m_send_ptr == nullptr) {
+                  return emc::err_fail;
+              }
+          }
+          if(l_mark_bit) {
+              l_chunk_size--;
+          }
+          while(size > 0) {
+              int l_return_size = size;
+              if(l_return_size > l_chunk_size) {
+                  l_return_size = l_chunk_size;
+              }
+              if(l_format == codec_format_base16) {
+                  l_result = emc::emcstage::emc_std_return_packet(channel, base16_encode(m_send_ptr, data, l_return_size), m_send_ptr);
+              } else
+              if(l_format == codec_format_base64) {
+                  l_result = emc::emcstage::emc_std_return_packet(channel, base64_encode(m_send_ptr, data, l_return_size), m_send_ptr);
+              } else
+              if(l_format == codec_format_cobs) {
+                  l_result = emc::emcstage::emc_std_return_packet(channel, cobs_encode(m_send_ptr, data, l_return_size, cobs_delimiter), m_send_ptr);
+              } else
+              if(l_mark_bit) {
+                  m_send_ptr[0] = packet_raw;
+                  std::memcpy(m_send_ptr + 1, data, l_return_size);
+                  l_result = emc::emcstage::emc_std_return_packet(channel, l_return_size + 1, m_send_ptr);
+              } else
+              if(l_format == codec_format_none) {
+                  l_result = emc::emcstage::emc_std_return_packet(channel, l_return_size, data);
+              } else
+                  return emc::err_fail;
+              if(l_result < 0) {
+                  return l_result;
+              }
+              data += l_return_size;
+              size -= l_return_size;
+          }
       }
       return emc::err_okay;
 }
 
 void  uart::emc_std_suspend(emc::gateway*) noexcept
 {
-      return emi_cache_dispose();
+      emi_send_dispose();
+      emi_cache_dispose();
 }
 
 /*namespace transport*/ }
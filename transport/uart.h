@@ -23,6 +23,7 @@
 **/
 #include <emc.h>
 #include <emc/pipeline.h>
+#include <emc/transport.h>
 
 namespace emc {
 namespace transport {
@@ -35,15 +36,36 @@ class uart: public emc::emcstage
   int             m_format;
   std::uint8_t*   m_cache_ptr;
   int             m_cache_size;
+  std::uint8_t*   m_send_ptr;
+  int             m_send_size;
   bool            m_ready_bit;
+  base16_decoder  m_base16_decoder;
+  base64_decoder  m_base64_decoder;
 
   public:
   static constexpr int codec_format_none = 0;
   static constexpr int codec_format_base16 = 1;
   static constexpr int codec_format_base64 = 2;
+  static constexpr int codec_format_cobs = 3;
+
+  /* cobs_delimiter
+     byte COBS encoded packets are kept clear of, so they can be framed by lines like the text traffic
+  */
+  static constexpr std::uint8_t cobs_delimiter = '\n';
+
+  /* packet_raw
+     first byte of the packets sent unencoded, along with the rest of the chunk, while the peer is within ring_machine;
+     none of the encodings ever starts a packet with it, so the receiving end tells both kinds apart whichever ring it
+     is in itself
+  */
+  static constexpr std::uint8_t packet_raw = '\n';
   protected:
           bool    emi_cache_reserve(int) noexcept;
           void    emi_cache_dispose() noexcept;
+          int     emi_get_format() const noexcept;
+          int     emi_get_chunk_size(int) const noexcept;
+          bool    emi_send_reserve() noexcept;
+          void    emi_send_dispose() noexcept;
   virtual bool    emc_std_resume(emc::gateway*) noexcept override;
   virtual int     emc_std_process_packet(int, int, std::uint8_t*) noexcept override;
   virtual int     emc_std_return_packet(int, int, std::uint8_t*) noexcept override;